@@ -132,6 +132,40 @@ namespace HarmoniaUI.containers
             set { _instance.Call("set_alert_manager", value); }
         }
 
+        /// <summary>
+        /// Listens to alerts of a type sent by this container or any of its descendants.
+        /// </summary>
+        /// <remarks>
+        /// Alerts bubble from the sending container up through its parent containers before reaching the alert manager.
+        /// A listener can stop the propagation, containers above and the alert manager then don't receive the alert.
+        /// </remarks>
+        /// <param name="alertType">The type of alert to listen to.</param>
+        /// <param name="callable">The callable receiving the alert.</param>
+        public void AddAlertListener(string alertType, Callable callable)
+        {
+            _instance.Call("add_alert_listener", alertType, callable);
+        }
+
+        /// <summary>
+        /// Removes a listener added with <see cref="AddAlertListener"/>.
+        /// </summary>
+        /// <param name="alertType">The type of alert the listener was added for.</param>
+        /// <param name="callable">The callable to remove.</param>
+        public void RemoveAlertListener(string alertType, Callable callable)
+        {
+            _instance.Call("remove_alert_listener", alertType, callable);
+        }
+
+        /// <summary>
+        /// Bubbles an alert from this container up through its parent containers.
+        /// </summary>
+        /// <param name="alert">The alert to bubble.</param>
+        /// <returns>True when a listener stopped the propagation.</returns>
+        public bool BubbleAlert(AlertWrapper alert)
+        {
+            return _instance.Call("bubble_alert", alert._instance).AsBool();
+        }
+
         /// <summary>
         /// Gets or sets the positioning type of the element.
         /// </summary>
@@ -206,6 +240,174 @@ namespace HarmoniaUI.containers
             set { _instance.Call("set_overflow_behaviour", (int)value); }
         }
 
+        /// <summary>
+        /// Gets or sets the layout mode of the element.
+        /// </summary>
+        /// <remarks>
+        /// This property determines how children of the element get sized and positioned, stacked as blocks or laid out in flex rows or columns.
+        /// </remarks>
+        public LayoutMode LayoutMode
+        {
+            get { return (LayoutMode)_instance.Call("get_layout_mode").AsInt32(); }
+            set { _instance.Call("set_layout_mode", (int)value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the column tracks of the element in grid layout mode, ex: "100px 1fr 2fr".
+        /// </summary>
+        /// <remarks>
+        /// Children are placed row by row into the columns. Tracks without a unit (ex: "auto") fit their widest cell.
+        /// </remarks>
+        public string GridColumnsStr
+        {
+            get { return _instance.Call("get_grid_columns_str").AsString(); }
+            set { _instance.Call("set_grid_columns_str", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the row tracks of the element in grid layout mode, ex: "50px 1fr".
+        /// </summary>
+        /// <remarks>
+        /// Tracks without a unit and rows past the defined ones fit their tallest cell.
+        /// </remarks>
+        public string GridRowsStr
+        {
+            get { return _instance.Call("get_grid_rows_str").AsString(); }
+            set { _instance.Call("set_grid_rows_str", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the main axis of the element in flex layout mode.
+        /// </summary>
+        /// <remarks>
+        /// Only used when LayoutMode is Flex.
+        /// </remarks>
+        public FlexDirection FlexDirection
+        {
+            get { return (FlexDirection)_instance.Call("get_flex_direction").AsInt32(); }
+            set { _instance.Call("set_flex_direction", (int)value); }
+        }
+
+        /// <summary>
+        /// Gets or sets whether children that do not fit go to a new line in flex layout mode.
+        /// </summary>
+        /// <remarks>
+        /// Only used when LayoutMode is Flex.
+        /// </remarks>
+        public FlexWrap FlexWrap
+        {
+            get { return (FlexWrap)_instance.Call("get_flex_wrap").AsInt32(); }
+            set { _instance.Call("set_flex_wrap", (int)value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the distribution of free space on the main axis in flex layout mode.
+        /// </summary>
+        /// <remarks>
+        /// Only used when LayoutMode is Flex.
+        /// </remarks>
+        public FlexJustify JustifyContent
+        {
+            get { return (FlexJustify)_instance.Call("get_justify_content").AsInt32(); }
+            set { _instance.Call("set_justify_content", (int)value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the alignment of children on the cross axis in flex layout mode.
+        /// </summary>
+        /// <remarks>
+        /// Stretch only applies to children without a set cross size (height for rows, width for columns).
+        /// </remarks>
+        public FlexAlign AlignItems
+        {
+            get { return (FlexAlign)_instance.Call("get_align_items").AsInt32(); }
+            set { _instance.Call("set_align_items", (int)value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the gap between rows in flex and grid layout modes, ex: "10px".
+        /// </summary>
+        /// <remarks>
+        /// Percentages are of the height of the element.
+        /// </remarks>
+        public string RowGapStr
+        {
+            get { return _instance.Call("get_row_gap_str").AsString(); }
+            set { _instance.Call("set_row_gap_str", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the gap between columns in flex and grid layout modes, ex: "10px".
+        /// </summary>
+        /// <remarks>
+        /// Percentages are of the width of the element.
+        /// </remarks>
+        public string ColumnGapStr
+        {
+            get { return _instance.Call("get_column_gap_str").AsString(); }
+            set { _instance.Call("set_column_gap_str", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets whether children outside of the clipped content area are culled.
+        /// </summary>
+        /// <remarks>
+        /// Culled children are not rendered and their processing is disabled until they scroll back into view.
+        /// </remarks>
+        public bool Culling
+        {
+            get { return _instance.Call("get_culling").AsBool(); }
+            set { _instance.Call("set_culling", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets whether backgrounds of the whole tree are drawn in batches, only used on the root container.
+        /// </summary>
+        /// <remarks>
+        /// Batched backgrounds are drawn below all other content of the root or of their content box.
+        /// </remarks>
+        public bool BatchBackgrounds
+        {
+            get { return _instance.Call("get_batch_backgrounds").AsBool(); }
+            set { _instance.Call("set_batch_backgrounds", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the share of free space the element takes in a flex parent.
+        /// </summary>
+        /// <remarks>
+        /// Free space on the main axis is split between children by their grow values.
+        /// </remarks>
+        public float FlexGrow
+        {
+            get { return _instance.Call("get_flex_grow").AsSingle(); }
+            set { _instance.Call("set_flex_grow", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets how much the element shrinks when its flex parent overflows.
+        /// </summary>
+        /// <remarks>
+        /// Shrinking is weighted by the base size of the element.
+        /// </remarks>
+        public float FlexShrink
+        {
+            get { return _instance.Call("get_flex_shrink").AsSingle(); }
+            set { _instance.Call("set_flex_shrink", value); }
+        }
+
+        /// <summary>
+        /// Gets or sets the base main axis size of the element in a flex parent, ex: "100px".
+        /// </summary>
+        /// <remarks>
+        /// When not set, width (rows) or height (columns) is used. Percentages are of the main axis size of the parent.
+        /// </remarks>
+        public string FlexBasisStr
+        {
+            get { return _instance.Call("get_flex_basis_str").AsString(); }
+            set { _instance.Call("set_flex_basis_str", value); }
+        }
+
         /// <summary>
         /// Gets or sets the horizontal scroll node path.
         /// </summary>
@@ -902,5 +1104,89 @@ namespace HarmoniaUI.containers
         {
             _instance.Call("update_presentation");
         }
+
+        /// <summary>
+        /// Starts a layout update, alerts and redraws of the following changes are held until the matching commit.
+        /// </summary>
+        public void BeginLayoutUpdate()
+        {
+            _instance.Call("begin_layout_update");
+        }
+
+        /// <summary>
+        /// Ends a layout update. The outermost commit relayouts, redraws and dispatches one alert with all changes.
+        /// </summary>
+        public void CommitLayoutUpdate()
+        {
+            _instance.Call("commit_layout_update");
+        }
+
+        /// <summary>
+        /// Checks whether a layout update is in progress.
+        /// </summary>
+        public bool IsLayoutUpdating()
+        {
+            return _instance.Call("is_layout_updating").AsBool();
+        }
+
+        /// <summary>
+        /// Finds containers under a global point using the spatial index of the root container.
+        /// </summary>
+        /// <param name="globalPoint">The point in global coordinates.</param>
+        /// <returns>Dictionary with "container" (deepest ContainerBox or null), "scrollable" (deepest scrollable ContainerBox or null) and "region" (PickRegion of the scrollable).</returns>
+        public Dictionary Pick(Vector2 globalPoint)
+        {
+            return _instance.Call("pick", globalPoint).AsGodotDictionary();
+        }
+
+        /// <summary>
+        /// Finds the deepest scrollable container under a global point.
+        /// </summary>
+        /// <param name="globalPoint">The point in global coordinates.</param>
+        /// <returns>The scrollable container or null when there is none.</returns>
+        public ContainerBox GetScrollableAt(Vector2 globalPoint)
+        {
+            GodotObject scrollable = _instance.Call("get_scrollable_at", globalPoint).AsGodotObject();
+            return scrollable == null ? null : new ContainerBox(scrollable);
+        }
+
+        /// <summary>
+        /// Gets or sets whether layout work of all containers is profiled.
+        /// </summary>
+        /// <remarks>
+        /// Totals of the last frame are shown by the "Harmonia Layout" Performance monitors.
+        /// </remarks>
+        public bool LayoutProfiling
+        {
+            get { return _instance.Call("is_layout_profiling").AsBool(); }
+            set { _instance.Call("set_layout_profiling", value); }
+        }
+
+        /// <summary>
+        /// Gets the layout profile of this container.
+        /// </summary>
+        /// <returns>Dictionary with relayouts, times (usec) and set_position/set_size calls, and the same totals of the whole subtree in "subtree".</returns>
+        public Dictionary GetLayoutProfile()
+        {
+            return _instance.Call("get_layout_profile").AsGodotDictionary();
+        }
+
+        /// <summary>
+        /// Gets the layout profiles of this container and its descendants, the slowest first.
+        /// </summary>
+        /// <param name="limit">Maximum number of profiles, -1 for all.</param>
+        /// <returns>Profiles with the "container" they belong to.</returns>
+        public Array<Dictionary> GetLayoutHotspots(int limit = 10)
+        {
+            return new Array<Dictionary>(_instance.Call("get_layout_hotspots", limit).AsGodotArray());
+        }
+
+        /// <summary>
+        /// Clears the layout profiles of this container and its descendants.
+        /// </summary>
+        public void ResetLayoutProfile()
+        {
+            _instance.Call("reset_layout_profile");
+        }
     }
 }
@@ -87,6 +87,138 @@
             /// This is a viewport height unit, written short 'vh' in values, ex: '10vh'
             /// </summary>
             ViewportHeight,
+            /// <summary>
+            /// This is a fraction unit, a share of the free space of grid tracks, written short 'fr' in values, ex: '1fr'
+            /// </summary>
+            Fraction,
+        };
+
+        /// <summary>
+        /// Enum used for the layout mode of containers, how children of a container get sized and positioned.
+        /// </summary>
+        public enum LayoutMode
+        {
+            /// <summary>
+            /// Normal, children are stacked from top to bottom
+            /// </summary>
+            Block,
+            /// <summary>
+            /// Children are laid out in rows or columns, see FlexDirection
+            /// </summary>
+            Flex,
+            /// <summary>
+            /// Children are placed row by row into grid column and row tracks
+            /// </summary>
+            Grid,
+        };
+
+        /// <summary>
+        /// Enum used for the main axis of flex containers.
+        /// </summary>
+        public enum FlexDirection
+        {
+            /// <summary>
+            /// Left to right
+            /// </summary>
+            Row,
+            /// <summary>
+            /// Right to left
+            /// </summary>
+            RowReverse,
+            /// <summary>
+            /// Top to bottom
+            /// </summary>
+            Column,
+            /// <summary>
+            /// Bottom to top
+            /// </summary>
+            ColumnReverse,
+        };
+
+        /// <summary>
+        /// Enum used for line breaking of flex containers.
+        /// </summary>
+        public enum FlexWrap
+        {
+            /// <summary>
+            /// Single line, items shrink or overflow
+            /// </summary>
+            NoWrap,
+            /// <summary>
+            /// Items that do not fit go to a new line
+            /// </summary>
+            Wrap,
+        };
+
+        /// <summary>
+        /// Enum used for distributing free space along the main axis of flex containers.
+        /// </summary>
+        public enum FlexJustify
+        {
+            /// <summary>
+            /// Items packed to the start
+            /// </summary>
+            Start,
+            /// <summary>
+            /// Items packed to the end
+            /// </summary>
+            End,
+            /// <summary>
+            /// Items packed to the center
+            /// </summary>
+            Center,
+            /// <summary>
+            /// Free space between items, none at the edges
+            /// </summary>
+            SpaceBetween,
+            /// <summary>
+            /// Free space around items, half of it at the edges
+            /// </summary>
+            SpaceAround,
+            /// <summary>
+            /// Same free space between items and at the edges
+            /// </summary>
+            SpaceEvenly,
+        };
+
+        /// <summary>
+        /// Enum used for aligning items on the cross axis of flex containers.
+        /// </summary>
+        public enum FlexAlign
+        {
+            /// <summary>
+            /// Aligned to the start of the line
+            /// </summary>
+            Start,
+            /// <summary>
+            /// Aligned to the end of the line
+            /// </summary>
+            End,
+            /// <summary>
+            /// Centered in the line
+            /// </summary>
+            Center,
+            /// <summary>
+            /// Items without a set cross size fill the line
+            /// </summary>
+            Stretch,
+        };
+
+        /// <summary>
+        /// Enum used for the part of a scrollable container that is under a picked point.
+        /// </summary>
+        public enum PickRegion
+        {
+            /// <summary>
+            /// No scrollable container under the point
+            /// </summary>
+            None,
+            Content,
+            VerticalScrollbar,
+            /// <summary>
+            /// Includes the checking area above the scrollbar
+            /// </summary>
+            HorizontalScrollbar,
         };
     }
-}
+}
\ No newline at end of file
@@ -33,6 +33,96 @@ namespace HarmoniaUI.core.systems.alert
             _instance.Call("dispatch_alert", alert._instance);
         }
 
+        /// <summary>
+        /// Dispatches an alert right away, even when the manager is in deferred mode.
+        /// </summary>
+        /// <param name="alert">The alert to dispatch.</param>
+        public void DispatchAlertImmediate(AlertWrapper alert)
+        {
+            _instance.Call("dispatch_alert_immediate", alert._instance);
+        }
+
+        /// <summary>
+        /// Posts an alert from any thread, it is dispatched on the main thread.
+        /// </summary>
+        /// <remarks>
+        /// Posted alerts are dispatched at the end of the frame or at the next flush, in the order each thread posted them.
+        /// The posting thread must not use the alert afterwards.
+        /// </remarks>
+        /// <param name="alert">The alert to post.</param>
+        public void PostAlert(AlertWrapper alert)
+        {
+            _instance.Call("post_alert", alert._instance);
+        }
+
+        /// <summary>
+        /// Dispatches the posted alerts right away, must be called on the main thread.
+        /// </summary>
+        public void DrainPostedAlerts()
+        {
+            _instance.Call("drain_posted_alerts");
+        }
+
+        /// <summary>
+        /// Gets or sets whether alerts are queued and merged until the next flush.
+        /// </summary>
+        /// <remarks>
+        /// Queued alerts are flushed after the layout pass or at the end of the frame, in the order they were first queued.
+        /// Turning deferred mode off flushes the queue.
+        /// </remarks>
+        public bool DeferredMode
+        {
+            get { return _instance.Call("get_deferred_mode").AsBool(); }
+            set { _instance.Call("set_deferred_mode", value); }
+        }
+
+        /// <summary>
+        /// Dispatches all queued alerts.
+        /// </summary>
+        public void FlushAlerts()
+        {
+            _instance.Call("flush_alerts");
+        }
+
+        /// <summary>
+        /// Gets the number of queued alerts.
+        /// </summary>
+        /// <returns>The number of alerts waiting for a flush.</returns>
+        public int GetQueuedAlertCount()
+        {
+            return _instance.Call("get_queued_alert_count").AsInt32();
+        }
+
+        /// <summary>
+        /// Gets whether the extension was built with alert stats (scons alert_stats=yes).
+        /// </summary>
+        /// <returns>True when alert stats are recorded.</returns>
+        public bool IsAlertStatsEnabled()
+        {
+            return _instance.Call("is_alert_stats_enabled").AsBool();
+        }
+
+        /// <summary>
+        /// Gets dispatch counts, subscriber counts and handler latency histograms by alert type name.
+        /// </summary>
+        /// <remarks>
+        /// Empty unless the extension was built with alert stats.
+        /// Histogram bucket i counts handler calls under 2^i microseconds.
+        /// </remarks>
+        /// <returns>The stats dictionary.</returns>
+        public Godot.Collections.Dictionary GetAlertStats()
+        {
+            return _instance.Call("get_alert_stats").AsGodotDictionary();
+        }
+
+        /// <summary>
+        /// Clears the stats of this alert manager.
+        /// </summary>
+        public void ResetAlertStats()
+        {
+            _instance.Call("reset_alert_stats");
+        }
+
         /// <summary>
         /// Adds a binding to an alert type, associating it with a callable to be executed when triggered.
         /// </summary>
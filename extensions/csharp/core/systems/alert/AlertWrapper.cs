@@ -41,5 +41,49 @@ namespace HarmoniaUI.core.systems.alert
         {
             return _instance.Call("get_alert_name").AsString();
         }
+
+        /// <summary>
+        /// Sets the object dispatching the alert, deferred alert managers merge duplicates per sender.
+        /// </summary>
+        /// <param name="sender">The sending object.</param>
+        public void SetSender(GodotObject sender)
+        {
+            _instance.Call("set_sender", sender);
+        }
+
+        /// <summary>
+        /// Gets the object which dispatched the alert.
+        /// </summary>
+        /// <returns>The sender, or null when it was freed or never set.</returns>
+        public GodotObject GetSender()
+        {
+            return _instance.Call("get_sender").AsGodotObject();
+        }
+
+        /// <summary>
+        /// Stops the alert from bubbling to the containers above the current one and to the alert manager.
+        /// </summary>
+        public void StopPropagation()
+        {
+            _instance.Call("stop_propagation");
+        }
+
+        /// <summary>
+        /// Gets whether a listener stopped the propagation of the alert.
+        /// </summary>
+        /// <returns>True when the propagation was stopped.</returns>
+        public bool IsPropagationStopped()
+        {
+            return _instance.Call("is_propagation_stopped").AsBool();
+        }
+
+        /// <summary>
+        /// Gets the container whose listeners are handling the alert while it bubbles.
+        /// </summary>
+        /// <returns>The current container, or null outside of bubbling.</returns>
+        public GodotObject GetCurrentTarget()
+        {
+            return _instance.Call("get_current_target").AsGodotObject();
+        }
     }
-}
+}
\ No newline at end of file
@@ -24,5 +24,13 @@ namespace HarmoniaUI.core.systems.alert.layout
         {
             return _instance.Call("get_alert_name").AsString();
         }
+
+        /// <summary>
+        /// Gets bits (1 &lt;&lt; LayoutChanged) of everything that was changed, merged alerts carry more than one.
+        /// </summary>
+        public int GetChangedMask()
+        {
+            return _instance.Call("get_changed_mask").AsInt32();
+        }
     }
 }
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifdef HARMONIA_BENCHMARKS
+
+#include <godot_cpp/godot.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+using namespace godot;
+
+/// @brief In-engine microbenchmarks of the String based helpers of commons/ (parser, string helpers, converters).
+///
+/// Only built with HARMONIA_BENCHMARKS (scons engine_benchmarks=yes), run by tests/harmonia_lab/benchmarks/commons_benchmark.gd.
+/// Godot Strings allocate inside of the engine, which exposes no allocation counter to extensions. Instead the static memory
+/// retained per operation and the rise of the static memory peak are reported (debug builds only), the native benchmarks
+/// (scons benchmarks) count allocations of the Godot independent code.
+class HarmoniaBenchmarks : public RefCounted
+{
+    GDCLASS(HarmoniaBenchmarks, RefCounted);
+public:
+    HarmoniaBenchmarks() = default;
+    ~HarmoniaBenchmarks() = default;
+
+    /// @brief Runs all commons benchmarks.
+    /// @param iterations Operations per benchmark
+    /// @return Results, each with name, iterations, total_msec, nsec_per_op, ops_per_sec, memory_tracked,
+    /// static_memory_delta_per_op (bytes), static_memory_peak_delta (bytes) and checksum.
+    Array run_commons(int iterations = 200000);
+
+protected:
+    static void _bind_methods();
+
+private:
+    /// @brief Sum of the results of all operations, returned so the work isn't optimized out.
+    double checksum {0};
+
+    template <class Function>
+    Dictionary measure(const String& name, int iterations, Function function);
+};
+
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "commons/unit_converter.h"
+#include "commons/unit_conversion.h"
 #include "core/harmonia.h"
 
 /// @brief A wrapper unit converter for easy use in containers.
@@ -18,34 +19,6 @@ public:
     /// @return Width in the provided unit type
     static double get_width(LengthPair pair, double parent_width, Vector2i window_size, int unit_type = Harmonia::Unit::PIXEL);
     
-    /// @brief Gets width in pixels from any correct length pair.
-    /// @param pair Length and unit
-    /// @param parent_width Width of the parent container
-    /// @param window_size Root viewport size
-    /// @return Width in pixels
-    static double get_width_px(LengthPair pair, double parent_width, Vector2i window_size);
-
-    /// @brief Gets width in vw (viewport width) from any correct length pair.
-    /// @param pair Length and unit
-    /// @param parent_width Width of the parent container
-    /// @param window_size Root viewport size
-    /// @return Width in vw
-    static double get_width_vw(LengthPair pair, double parent_width, Vector2i window_size);
-
-    /// @brief Gets width in vh (viewport height) from any correct length pair.
-    /// @param pair Length and unit
-    /// @param parent_width Width of the parent container
-    /// @param window_size Root viewport size
-    /// @return Width in vh
-    static double get_width_vh(LengthPair pair, double parent_width, Vector2i window_size);
-
-    /// @brief Gets width in % (percentage) from any correct length pair.
-    /// @param pair Length and unit
-    /// @param parent_width Width of the parent container
-    /// @param window_size Root viewport size
-    /// @return Width in %/pct
-    static double get_width_percentage(LengthPair pair, double parent_width, Vector2i window_size);
-    
     /// @brief Gets height in any unit type from any correct length pair.
     /// @param pair Length and unit
     /// @param parent_height Height of the parent container
@@ -54,31 +27,22 @@ public:
     /// @return height in the provided unit type
     static double get_height(LengthPair pair, double parent_height, Vector2i window_size, int unit_type = Harmonia::Unit::PIXEL);
     
-    /// @brief Gets height in pixels from any correct length pair.
-    /// @param pair Length and unit
-    /// @param parent_height Height of the parent container
-    /// @param window_size Root viewport size
-    /// @return Height in pixels
-    static double get_height_px(LengthPair pair, double parent_height, Vector2i window_size);
-
-    /// @brief Gets height in vw (viewport height) from any correct length pair.
-    /// @param pair Length and unit
+    /// @brief Gets a context for unit conversions of a container.
+    /// @param parent_width Width of the parent container
     /// @param parent_height Height of the parent container
     /// @param window_size Root viewport size
-    /// @return Height in vw
-    static double get_height_vw(LengthPair pair, double parent_height, Vector2i window_size);
+    static UnitContext get_context(double parent_width, double parent_height, Vector2i window_size);
 
-    /// @brief Gets height in vh (viewport height) from any correct length pair.
-    /// @param pair Length and unit
-    /// @param parent_height Height of the parent container
+    /// @brief Gets widths or heights in pixels of many lengths at once (see UnitBatch), same results as get_width/get_height in pixels.
+    /// @param units Units of the lengths (Harmonia::Unit)
+    /// @param lengths Lengths in their units
+    /// @param parent_sizes Same axis sizes of the parent containers
     /// @param window_size Root viewport size
-    /// @return Height in vh
-    static double get_height_vh(LengthPair pair, double parent_height, Vector2i window_size);
+    /// @param results Output pixel values
+    /// @param count Number of lengths
+    static void get_px_batch(const int32_t* units, const double* lengths, const double* parent_sizes, Vector2i window_size, double* results, size_t count);
 
-    /// @brief Gets height in % (percentage) from any correct length pair.
-    /// @param pair Length and unit
-    /// @param parent_height Height of the parent container
-    /// @param window_size Root viewport size
-    /// @return Height in %/pct
-    static double get_height_percentage(LengthPair pair, double parent_height, Vector2i window_size);
+    /// @brief Gets widths or heights in pixels of many lengths at once, packed array version of get_px_batch.
+    /// @return Pixel values, empty when the array sizes don't match.
+    static PackedFloat64Array get_px_batch(const PackedInt32Array& units, const PackedFloat64Array& lengths, const PackedFloat64Array& parent_sizes, Vector2i window_size);
 };
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+
+/// @brief Single pass parser of length strings ("10px", "50%", "1'000.5vw"), works on the raw character buffer without any allocation.
+///
+/// Spaces are skipped anywhere, a number is read with readable chars (' and repeated dots) ignored and an implied zero (".45"),
+/// followed by one of the unit suffixes. Results match the String based parser it replaced (replace, get_string_number, to_float),
+/// including Godot's String::to_float rounding, and it doesn't depend on Godot so the native benchmarks can measure it.
+class LengthParser
+{
+public:
+    LengthParser() = default;
+    ~LengthParser() = default;
+
+    /// @brief Units, values match Harmonia::Unit
+    enum Unit {
+        NOT_SET = -1,
+        PIXEL,
+        PERCENTAGE,
+        VIEWPORT_WIDTH,
+        VIEWPORT_HEIGHT,
+        FRACTION,
+    };
+
+    /// @brief Result of parsing, anything but PARSE_OK means the string wasn't a valid length.
+    enum Status {
+        PARSE_OK, // Number with a known unit
+        PARSE_EMPTY, // Nothing but spaces
+        PARSE_NO_NUMBER, // No digits before the unit, length is 0
+        PARSE_NO_UNIT, // Number without a unit, unit is NOT_SET
+        PARSE_UNKNOWN_UNIT, // Number followed by an unknown unit, unit is NOT_SET
+    };
+
+    struct Result {
+        /// @brief One of Unit
+        int unit {NOT_SET};
+        /// @brief The length, % are actual percentages ex. 10% is 0.1
+        double length {0};
+    };
+
+    /// @brief Parses a length string.
+    /// @tparam Char Character type of the buffer (char32_t for Godot Strings, char for native code)
+    /// @param chars Characters of the string, don't have to be null terminated
+    /// @param length Count of characters
+    /// @param result Set to the parsed length, also when parsing fails (unit NOT_SET or length 0)
+    /// @return Status of parsing
+    template <class Char>
+    static Status parse(const Char* chars, int64_t length, Result& result);
+
+private:
+    /// @brief Count of mantissa digits that are used, further digits can't change a double (same as Godot's String::to_float).
+    static constexpr int MAX_MANTISSA_DIGITS = 18;
+    /// @brief Largest decimal exponent, larger ones already overflow or underflow.
+    static constexpr int MAX_EXPONENT = 511;
+
+    static constexpr bool is_digit(char32_t character);
+
+    /// @brief Scales a mantissa by a power of 10 the way Godot's String::to_float does.
+    static double scale(double mantissa, int exponent);
+
+    static int get_unit(char32_t first, char32_t second, int count);
+};
+
+constexpr bool LengthParser::is_digit(char32_t character){
+    return character >= '0' && character <= '9';
+}
+
+inline double LengthParser::scale(double mantissa, int exponent){
+    // Powers up to 1e22 are exact, so a single multiplication or division is correctly rounded.
+    static constexpr double EXACT_POWERS[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    static constexpr double BINARY_POWERS[] = {1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
+
+    bool negative = exponent < 0;
+    if(negative) exponent = -exponent;
+    if(exponent > MAX_EXPONENT) exponent = MAX_EXPONENT;
+
+    double power = 1;
+    if(exponent <= 22){
+        power = EXACT_POWERS[exponent];
+    }else{
+        for (int i = 0; exponent != 0; exponent >>= 1, i++)
+        {
+            if(exponent & 1) power *= BINARY_POWERS[i];
+        }
+    }
+    return negative ? mantissa / power : mantissa * power;
+}
+
+inline int LengthParser::get_unit(char32_t first, char32_t second, int count){
+    if(count == 1){
+        return first == '%' ? PERCENTAGE : NOT_SET;
+    }else if(count == 2){
+        if(first == 'p' && second == 'x') return PIXEL;
+        if(first == 'v' && second == 'w') return VIEWPORT_WIDTH;
+        if(first == 'v' && second == 'h') return VIEWPORT_HEIGHT;
+        if(first == 'f' && second == 'r') return FRACTION;
+    }
+    return NOT_SET;
+}
+
+template <class Char>
+LengthParser::Status LengthParser::parse(const Char* chars, int64_t length, Result& result){
+    result = Result();
+
+    bool negative {false};
+    bool dot_used {false};
+    bool has_digits {false};
+    uint64_t mantissa {0};
+    int mantissa_digits {0}; // Including ignored digits past MAX_MANTISSA_DIGITS
+    int integer_digits {0};
+    int64_t read {0}; // Characters read, without spaces
+    int64_t i {0};
+
+    for (; i < length; i++)
+    {
+        char32_t character = static_cast<char32_t>(chars[i]);
+        if(character == ' ') continue;
+        read++;
+
+        if(read == 1 && (character == '-' || character == '+')){
+            negative = character == '-';
+            continue;
+        }
+        if(character == '\'') continue;
+        if(character == '.'){
+            if(dot_used) continue;
+            // The implied zero only counts as a mantissa digit, it doesn't change the value.
+            if(read == 1 || (read == 2 && negative)) mantissa_digits++;
+            integer_digits = mantissa_digits;
+            dot_used = true;
+            continue;
+        }
+        if(!is_digit(character)) break;
+
+        if(mantissa_digits < MAX_MANTISSA_DIGITS){
+            mantissa = mantissa * 10 + (character - '0');
+        }
+        mantissa_digits++;
+        has_digits = true;
+    }
+
+    if(read == 0) return PARSE_EMPTY;
+
+    if(mantissa_digits > 0){
+        if(!dot_used) integer_digits = mantissa_digits;
+        int used_digits = mantissa_digits < MAX_MANTISSA_DIGITS ? mantissa_digits : MAX_MANTISSA_DIGITS;
+        result.length = scale(static_cast<double>(mantissa), integer_digits - used_digits);
+    }
+    if(negative) result.length = -result.length;
+
+    if(i == length){
+        return has_digits ? PARSE_NO_UNIT : PARSE_NO_NUMBER;
+    }
+
+    // Unit suffix, the rest of the string without spaces.
+    char32_t unit_chars[2] {0, 0};
+    int unit_length {0};
+    for (; i < length; i++)
+    {
+        char32_t character = static_cast<char32_t>(chars[i]);
+        if(character == ' ') continue;
+        if(unit_length < 2) unit_chars[unit_length] = character;
+        unit_length++;
+    }
+
+    result.unit = get_unit(unit_chars[0], unit_chars[1], unit_length);
+    if(result.unit == PERCENTAGE){
+        result.length = result.length / 100;
+    }
+
+    if(!has_digits) return PARSE_NO_NUMBER;
+    return result.unit == NOT_SET ? PARSE_UNKNOWN_UNIT : PARSE_OK;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include "commons/unit_converter.h"
+
+/// @brief Axis of a converted length, percentages are calculated from the same axis parent size.
+enum class UnitAxis {
+    WIDTH,
+    HEIGHT,
+};
+
+/// @brief Sizes the unit conversions are based on.
+struct UnitContext {
+    /// @brief Width of the parent container, base of width percentages
+    double parent_width {0};
+    /// @brief Height of the parent container, base of height percentages
+    double parent_height {0};
+    /// @brief Root viewport width, base of vw
+    double viewport_width {0};
+    /// @brief Root viewport height, base of vh
+    double viewport_height {0};
+};
+
+/// @brief Compile-time specialized unit conversions, each (from, to, axis) combination is its own function without any dispatch.
+///
+/// Callers with units known at compile time use convert<From, To, Axis>(), callers with runtime units go through a jump table built from those.
+/// Unknown units convert to 0, that includes Harmonia::FRACTION (== UNIT_COUNT) which is only a share of grid free space.
+class UnitConversion
+{
+public:
+    UnitConversion() = default;
+    ~UnitConversion() = default;
+
+    /// @brief Units, values match Harmonia::Unit (without NOT_SET)
+    enum Unit {
+        PIXEL,
+        PERCENTAGE,
+        VIEWPORT_WIDTH,
+        VIEWPORT_HEIGHT,
+        UNIT_COUNT,
+    };
+
+    /// @brief Converted length function, entry of the jump tables.
+    using Function = double (*)(double length, const UnitContext& context);
+
+    /// @brief Converts a length from a unit into another unit, both known at compile time.
+    /// @tparam From Unit of the length
+    /// @tparam To Unit the length should be converted into
+    /// @tparam Axis Axis of the length, chooses the parent size percentages are based on
+    /// @param length Length in the From unit
+    /// @param context Parent and viewport sizes
+    /// @return Length in the To unit
+    template <int From, int To, UnitAxis Axis>
+    static constexpr double convert(double length, const UnitContext& context);
+
+    /// @brief Converts a length from a runtime unit into a compile time unit, goes through a single table lookup.
+    template <int To, UnitAxis Axis>
+    static double convert_to(int from, double length, const UnitContext& context);
+
+    /// @brief Converts a length between runtime units, goes through a single table lookup.
+    static double convert(int from, int to, UnitAxis axis, double length, const UnitContext& context);
+
+private:
+    static constexpr bool is_valid(int unit);
+
+    template <UnitAxis Axis, std::size_t... Indexes>
+    static constexpr std::array<Function, sizeof...(Indexes)> make_table(std::index_sequence<Indexes...>);
+
+    template <int To, UnitAxis Axis, std::size_t... Indexes>
+    static constexpr std::array<Function, sizeof...(Indexes)> make_row(std::index_sequence<Indexes...>);
+
+    static constexpr std::size_t TABLE_SIZE = UNIT_COUNT * UNIT_COUNT;
+};
+
+constexpr bool UnitConversion::is_valid(int unit){
+    return unit >= 0 && unit < UNIT_COUNT;
+}
+
+template <int From, int To, UnitAxis Axis>
+constexpr double UnitConversion::convert(double length, const UnitContext& context){
+    const double parent_size = Axis == UnitAxis::WIDTH ? context.parent_width : context.parent_height;
+
+    if constexpr (!is_valid(From) || !is_valid(To)){
+        return 0;
+    }else if constexpr (From == To){
+        return length;
+    }else if constexpr (From == PIXEL){
+        if constexpr (To == PERCENTAGE) return UnitConverter::px_to_percentage(length, parent_size);
+        else if constexpr (To == VIEWPORT_WIDTH) return UnitConverter::px_to_vw(length, context.viewport_width);
+        else return UnitConverter::px_to_vh(length, context.viewport_height);
+    }else if constexpr (From == PERCENTAGE){
+        if constexpr (To == PIXEL) return UnitConverter::percentage_to_px(length, parent_size);
+        else if constexpr (To == VIEWPORT_WIDTH) return UnitConverter::percentage_to_vw(length, context.viewport_width, parent_size);
+        else return UnitConverter::percentage_to_vh(length, context.viewport_height, parent_size);
+    }else if constexpr (From == VIEWPORT_WIDTH){
+        if constexpr (To == PIXEL) return UnitConverter::vw_to_px(length, context.viewport_width);
+        else if constexpr (To == PERCENTAGE) return UnitConverter::vw_to_percentage(length, context.viewport_width, parent_size);
+        else return UnitConverter::vw_to_vh(length, context.viewport_width, context.viewport_height);
+    }else{
+        if constexpr (To == PIXEL) return UnitConverter::vh_to_px(length, context.viewport_height);
+        else if constexpr (To == PERCENTAGE) return UnitConverter::vh_to_percentage(length, context.viewport_height, parent_size);
+        else return UnitConverter::vh_to_vw(length, context.viewport_width, context.viewport_height);
+    }
+}
+
+template <UnitAxis Axis, std::size_t... Indexes>
+constexpr std::array<UnitConversion::Function, sizeof...(Indexes)> UnitConversion::make_table(std::index_sequence<Indexes...>){
+    // Index is from * UNIT_COUNT + to
+    return {{ &convert<static_cast<int>(Indexes / UNIT_COUNT), static_cast<int>(Indexes % UNIT_COUNT), Axis>... }};
+}
+
+template <int To, UnitAxis Axis, std::size_t... Indexes>
+constexpr std::array<UnitConversion::Function, sizeof...(Indexes)> UnitConversion::make_row(std::index_sequence<Indexes...>){
+    return {{ &convert<static_cast<int>(Indexes), To, Axis>... }};
+}
+
+template <int To, UnitAxis Axis>
+inline double UnitConversion::convert_to(int from, double length, const UnitContext& context){
+    static constexpr std::array<Function, UNIT_COUNT> row = make_row<To, Axis>(std::make_index_sequence<UNIT_COUNT>());
+    if(!is_valid(from)) return 0;
+    return row[from](length, context);
+}
+
+inline double UnitConversion::convert(int from, int to, UnitAxis axis, double length, const UnitContext& context){
+    static constexpr std::array<Function, TABLE_SIZE> width_table = make_table<UnitAxis::WIDTH>(std::make_index_sequence<TABLE_SIZE>());
+    static constexpr std::array<Function, TABLE_SIZE> height_table = make_table<UnitAxis::HEIGHT>(std::make_index_sequence<TABLE_SIZE>());
+    if(!is_valid(from) || !is_valid(to)) return 0;
+
+    const std::array<Function, TABLE_SIZE>& table = axis == UnitAxis::WIDTH ? width_table : height_table;
+    return table[from * UNIT_COUNT + to](length, context);
+}
@@ -6,25 +6,25 @@ class UnitConverter
 public:
     UnitConverter() = default;
     ~UnitConverter() = default;
-    static double px_to_percentage(double px, double base);
-    static double px_to_vw(double px, double width);
-    static double px_to_vh(double px, double height);
-    static double vw_to_percentage(double vw, double window_width, double pct_base);
-    static double vw_to_px(double vw, double width);
-    static double vw_to_vh(double vw, double width, double height);
-    static double vh_to_percentage(double vh, double window_height, double pct_base);
-    static double vh_to_px(double vh, double height);
-    static double vh_to_vw(double vh, double width, double height);
-    static double percentage_to_vw(double percentage, double window_width, double pct_base);
-    static double percentage_to_px(double percentage, double base);
-    static double percentage_to_vh(double percentage, double window_height, double pct_base);
+    static constexpr double px_to_percentage(double px, double base);
+    static constexpr double px_to_vw(double px, double width);
+    static constexpr double px_to_vh(double px, double height);
+    static constexpr double vw_to_percentage(double vw, double window_width, double pct_base);
+    static constexpr double vw_to_px(double vw, double width);
+    static constexpr double vw_to_vh(double vw, double width, double height);
+    static constexpr double vh_to_percentage(double vh, double window_height, double pct_base);
+    static constexpr double vh_to_px(double vh, double height);
+    static constexpr double vh_to_vw(double vh, double width, double height);
+    static constexpr double percentage_to_vw(double percentage, double window_width, double pct_base);
+    static constexpr double percentage_to_px(double percentage, double base);
+    static constexpr double percentage_to_vh(double percentage, double window_height, double pct_base);
 };
 
 /// @brief pixel to percentage
 /// @param px value
 /// @param base base from which percentage should be calculated. (ex. container width)
 /// @return percentage (format: 0.5 (written: 50%) (not 50))
-inline double UnitConverter::px_to_percentage(double px, double base)
+constexpr double UnitConverter::px_to_percentage(double px, double base)
 {
     return px/base;
 }
@@ -33,7 +33,7 @@ inline double UnitConverter::px_to_percentage(double px, double base)
 /// @param px value
 /// @param width width of the viewport
 /// @return vw value (format: 50 (not 0.5))
-inline double UnitConverter::px_to_vw(double px, double width)
+constexpr double UnitConverter::px_to_vw(double px, double width)
 {
     return px/width * 100;
 }
@@ -42,7 +42,7 @@ inline double UnitConverter::px_to_vw(double px, double width)
 /// @param px value
 /// @param height height of the viewport
 /// @return vh value (format: 50 (not 0.5))
-inline double UnitConverter::px_to_vh(double px, double height)
+constexpr double UnitConverter::px_to_vh(double px, double height)
 {
     return px/height * 100;
 }
@@ -52,7 +52,7 @@ inline double UnitConverter::px_to_vh(double px, double height)
 /// @param window_width Viewport width
 /// @param pct_base width from which percentage is calculated (ex. parent container)
 /// @return percentage value from the pct_base
-inline double UnitConverter::vw_to_percentage(double vw, double window_width, double pct_base)
+constexpr double UnitConverter::vw_to_percentage(double vw, double window_width, double pct_base)
 {
     return vw/100 * window_width/pct_base;
 }
@@ -61,7 +61,7 @@ inline double UnitConverter::vw_to_percentage(double vw, double window_width, do
 /// @param vw value
 /// @param width viewport width value
 /// @return pixel value
-inline double UnitConverter::vw_to_px(double vw, double width)
+constexpr double UnitConverter::vw_to_px(double vw, double width)
 {
     return vw/100*width;
 }
@@ -71,7 +71,7 @@ inline double UnitConverter::vw_to_px(double vw, double width)
 /// @param width viewport width
 /// @param height viewport height
 /// @return vh value
-inline double UnitConverter::vw_to_vh(double vw, double width, double height){
+constexpr double UnitConverter::vw_to_vh(double vw, double width, double height){
     return ((vw * width / 100) / height) * 100;
 }
 
@@ -80,7 +80,7 @@ inline double UnitConverter::vw_to_vh(double vw, double width, double height){
 /// @param window_height Viewport height
 /// @param pct_base height from which percentage is calculated (ex. parent container)
 /// @return percentage value from the pct_base
-inline double UnitConverter::vh_to_percentage(double vh, double window_height, double pct_base)
+constexpr double UnitConverter::vh_to_percentage(double vh, double window_height, double pct_base)
 {
     return vh/100 * window_height/pct_base;
 }
@@ -89,7 +89,7 @@ inline double UnitConverter::vh_to_percentage(double vh, double window_height, d
 /// @param vh value
 /// @param height viewport height
 /// @return pixel value
-inline double UnitConverter::vh_to_px(double vh, double height)
+constexpr double UnitConverter::vh_to_px(double vh, double height)
 {
     return vh/100*height;
 }
@@ -99,7 +99,7 @@ inline double UnitConverter::vh_to_px(double vh, double height)
 /// @param width viewport width
 /// @param height viewport height
 /// @return vw value
-inline double UnitConverter::vh_to_vw(double vh, double width, double height){
+constexpr double UnitConverter::vh_to_vw(double vh, double width, double height){
     return ((vh * height / 100) / width) * 100;
 }
 
@@ -108,7 +108,7 @@ inline double UnitConverter::vh_to_vw(double vh, double width, double height){
 /// @param window_width viewport width
 /// @param pct_base width from which percentage was calculated (ex. parent container)
 /// @return percentage value
-inline double UnitConverter::percentage_to_vw(double percentage, double window_width, double pct_base)
+constexpr double UnitConverter::percentage_to_vw(double percentage, double window_width, double pct_base)
 {
     return (pct_base*percentage)/window_width*100;
 }
@@ -117,7 +117,7 @@ inline double UnitConverter::percentage_to_vw(double percentage, double window_w
 /// @param percentage value
 /// @param base base from which the percentage was calculated.
 /// @return percentage value
-inline double UnitConverter::percentage_to_px(double percentage, double base)
+constexpr double UnitConverter::percentage_to_px(double percentage, double base)
 {
     return base*percentage;
 }
@@ -127,7 +127,7 @@ inline double UnitConverter::percentage_to_px(double percentage, double base)
 /// @param window_height viewport height
 /// @param pct_base height from which percentage was calculated.
 /// @return percentage value
-inline double UnitConverter::percentage_to_vh(double percentage, double window_height, double pct_base)
+constexpr double UnitConverter::percentage_to_vh(double percentage, double window_height, double pct_base)
 {
      return (pct_base*percentage)/window_height*100;
 }
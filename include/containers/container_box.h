@@ -5,12 +5,19 @@
 #include <godot_cpp/classes/control.hpp>
 #include <godot_cpp/classes/input_event.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/classes/v_scroll_bar.hpp>
 #include <godot_cpp/classes/h_scroll_bar.hpp>
 #include "commons/container_unit_converter.h"
 #include "core/systems/alert/alert_manager.h"
+#include "core/systems/alert/layout/alert_layout_change.h"
 #include "core/harmonia.h"
+#include "core/layout/layout_node.h"
+#include "core/layout/spatial_index.h"
+#include "core/systems/profiling/layout_profiler.h"
 #include "containers/content_box.h"
+#include <vector>
+#include <unordered_map>
 
 using namespace godot;
 
@@ -25,17 +32,101 @@ public:
     /// @brief Alert of layout change, that being position, width, height or other layout change
     const String ALERT_LAYOUT_CHANGE = "layout-change";
 
-    /// @brief Update time from the last update
-    /// @note This will get removed in the future.
-    double update_time {0};
-
-    /// @brief The interval of updates 
-    /// @note This will get removed in the future.
-    double update_interval {1.0};
-
     void on_window_size_changed();
     void _ready();
-    void _process(double delta);
+
+    /// @brief Is the layout of this container out of date, set by layout setters and child changes.
+    bool layout_dirty {true};
+    /// @brief Is the layout of any container below this one out of date.
+    bool child_layout_dirty {false};
+    /// @brief Is a relayout already scheduled for the end of the frame, used only by the root container.
+    bool layout_scheduled {false};
+
+    /// @brief Marks this container for relayout, the relayout itself runs once at the end of the frame.
+    /// @note The parent container is marked as well, as it positions and measures overflow of this container.
+    void mark_layout_dirty();
+    /// @brief Deferred relayout of all dirty containers, called on the root container at the end of the frame.
+    void flush_layout();
+    /// @brief Single top-down layout pass, lays out this container when dirty (or forced) and then walks down into its children.
+    /// @note Each container is visited at most once, parents always resolve their size before their children.
+    /// @param force Should this container be relayouted even if it's not dirty (ex. its parent was relayouted)
+    void update_layout_pass(bool force = false);
+    /// @brief Lays out only this container, that being its size, overflows, content box and positions of its direct children.
+    /// @param children Children laid out by this container (see get_layout_children)
+    void update_layout(TypedArray<Node> children);
+    /// @brief Gets the nodes laid out by this container, children of the content box if this container uses one.
+    TypedArray<Node> get_layout_children();
+    /// @brief Gets the outermost ContainerBox (the one without a ContainerBox parent) of this containers tree.
+    ContainerBox* get_root_container();
+    /// @brief Called when children of this container or its content box get added, removed or moved.
+    void on_children_changed();
+
+    /// NOTE: Picking, the root container keeps a spatial index of the containers below it. It's rebuilt lazily after layout passes,
+    /// scrolling only moves the scope of the scrolled content (see SpatialIndex).
+
+    /// @brief Spatial index of the containers of this tree, used only by the root container.
+    SpatialIndex spatial_index;
+    /// @brief Containers of the spatial index, entry ids index into it.
+    std::vector<ObjectID> spatial_containers;
+    /// @brief Should the spatial index be rebuilt before the next pick, set by layout passes.
+    bool spatial_index_dirty {true};
+    /// @brief Scope of the content of this container in the spatial index of its root, -1 without a content box.
+    int spatial_scope {-1};
+    /// @brief Position of this container in its spatial index scope.
+    Vector2 spatial_origin;
+    /// @brief Rebuilds the spatial index from the current container rects, called on the root container.
+    void rebuild_spatial_index();
+    /// @brief Adds this container and visible containers below it into a spatial index.
+    /// @param scope Scope this container is in
+    /// @param origin Position of this container in the scope
+    /// @param depth Depth of this container in the tree
+    void add_spatial_entries(SpatialIndex& index, std::vector<ObjectID>& containers, int scope, Vector2 origin, int depth);
+    /// @brief Moves the scope of this containers content to the current scroll, called when the content box scrolls.
+    void update_spatial_scope();
+    /// @brief Finds containers under a global point in the spatial index of the root container.
+    SpatialIndex::Hit pick_hit(Vector2 global_point);
+    /// @brief Gets a container of the root spatial index by its entry id.
+    /// @return The container or nullptr when the id is -1 or the container was freed.
+    ContainerBox* get_spatial_container(int id);
+    /// @brief Finds containers under a global point, for custom picking.
+    /// @return Dictionary with 'container' (deepest ContainerBox or null), 'scrollable' (deepest scrollable ContainerBox or null) and 'region' (Harmonia::PickRegion of the scrollable)
+    Dictionary pick(Vector2 global_point);
+    /// @brief Gets the deepest scrollable container under a global point.
+    /// @return The container or nullptr when none
+    ContainerBox* get_scrollable_at(Vector2 global_point);
+
+    /// NOTE: Culling, children fully outside of the clipped area of a content box (nested clips included) are hidden from rendering
+    /// and their processing is disabled. Runs from the root container after each layout pass and from a container after its content scrolls.
+
+    /// @brief Should children outside of the clipped content area be culled. Default false (opt-in), culled children stop
+    /// processing, so scripts, timers and animations of off-screen children pause until they are scrolled into view.
+    bool culling {false};
+    /// @brief Sets culling, turning it off shows all culled children again.
+    void set_culling(bool value);
+    /// @brief Simple getter for culling.
+    bool get_culling();
+    /// @brief Clip inherited from the containers above in the local space of this container, kept for culling again on scroll.
+    Rect2 culling_clip;
+    /// @brief Is there an inherited clip, false for the root container and containers below it without a clip.
+    bool culling_has_clip {false};
+    /// @brief Culled children by their instance id, with their process mode from before culling.
+    /// @note Entries are dropped when a child is hidden or shown (visibility_changed), Godot makes its canvas item visible again on show.
+    std::unordered_map<uint64_t, Node::ProcessMode> culled_children;
+    /// @brief Culls children against the clip and walks down into the containers that stay visible.
+    /// @param clip Inherited clip in the local space of this container
+    /// @param has_clip Is there an inherited clip
+    void update_culling(Rect2 clip, bool has_clip);
+    /// @brief Hides a child from rendering and disables its processing, or restores both.
+    /// @note The process mode is restored only when it's still disabled, a mode set by a script while culled is kept.
+    void set_child_culled(Control* child, bool culled);
+    /// @brief Restores a culled child and stops watching its visibility, the entry has to be removed by the caller.
+    void uncull_child(Control* child, Node::ProcessMode process_mode);
+    /// @brief Drops a culled child that was hidden or shown and culls the children again.
+    void on_culled_child_visibility_changed(uint64_t id);
+    /// @brief Restores all culled children, including ones that are no longer children of this container.
+    void restore_culled_children();
+    /// @brief Called by the content box after it scrolled, moves its spatial index scope and culls again.
+    void on_content_scrolled();
 
     Harmonia::Visibility visibility {Harmonia::Visibility::OBJECT_VISIBLE};
     void set_visibility(Harmonia::Visibility new_visibility);
@@ -43,6 +134,8 @@ public:
     void apply_visibility();
 
     Size2 window_size;
+    /// @brief Sets the window size, geometry of this container and the ones below it is invalidated when it changed.
+    void set_window_size(const Size2& new_window_size);
 
     /// @brief Content box of this container if it's using one.
     ContentBox* content_box {nullptr};
@@ -63,9 +156,8 @@ public:
     /// @param overflow the overflows
     void check_overflows(Vector2 overflow);
 
-    /// @brief Updates this containers overflows calculated from children and other
-    /// @param children the children nodes of this container
-    void update_container_overflows(TypedArray<Node> children);
+    /// @brief Updates this containers overflows from the ones calculated by the layout solver
+    void update_container_overflows();
 
     /// @brief Negative oveflow on X axis specifically LEFT (in px)
     /// @note this is counted towards the normal overflow size and is applied to scrolls to move them according to overflow
@@ -162,6 +254,54 @@ public:
     /// @brief Functions as _draw but doesnt override the _draw instead it's used when draw notification is emmited.  
     void draw_ui();
 
+    /// NOTE: Batched backgrounds, opt-in on the root container. Backgrounds of the whole tree are submitted as rect lists of a few
+    /// canvas items owned by the root, one for the root area and one per content box so scrolling and clipping still apply.
+    /// Batched backgrounds are drawn below all other content of their area (root or content box).
+
+    /// @brief Should backgrounds of this tree be batched, only read on the root container. Default false.
+    bool batch_backgrounds {false};
+    /// @brief Sets background batching, containers of the tree draw their own backgrounds again when turned off.
+    void set_batch_backgrounds(bool value);
+    /// @brief Simple getter for background batching.
+    bool get_batch_backgrounds();
+    /// @brief Is the background of this container drawn by the batches of its root container.
+    bool is_background_batched();
+
+    /// @brief Backgrounds of a single area, submitted to its canvas item only when a rect or color changed.
+    struct BackgroundBatch {
+        RID canvas_item;
+        /// @brief Canvas item of the area (root container or content box) the batch is drawn in.
+        RID parent_item;
+        std::vector<Rect2> rects;
+        std::vector<Color> colors;
+        /// @brief Number of rects already compared in the current update.
+        size_t cursor {0};
+        /// @brief Has anything changed in the current update.
+        bool changed {false};
+    };
+    /// @brief Background batches of this tree, used only by the root container.
+    std::vector<BackgroundBatch> background_batches;
+    /// @brief Is a background update already scheduled for the end of the frame, used only by the root container.
+    bool backgrounds_scheduled {false};
+    /// @brief Requests a redraw of the background of this container, through the root batches when batched.
+    void queue_background_redraw();
+    /// @brief Deferred background update for changes that don't need a relayout (ex. background color), called on the root container.
+    void flush_backgrounds();
+    /// @brief Collects backgrounds of the tree and resubmits the batches that changed, called on the root container.
+    void update_background_batches();
+    /// @brief Adds backgrounds of this container and visible containers below it into the batches of the root container.
+    /// @param batch Batch of the area this container is in
+    /// @param origin Position of this container in the area
+    /// @param used_batches Number of batches taken in the current update
+    void add_batched_backgrounds(ContainerBox* root, size_t batch, Vector2 origin, size_t& used_batches);
+    /// @brief Takes the next batch of the current update for an area, creating its canvas item when needed.
+    /// @return Index of the batch
+    size_t acquire_background_batch(RID parent_item, size_t& used_batches);
+    /// @brief Frees canvas items of all background batches.
+    void free_background_batches();
+    /// @brief Queues redraw of this container and all containers below it.
+    void redraw_backgrounds();
+
     /// @brief Helper function for getting width of a provided LengthPair in any Harmonia unit. (Here to remove repetitions)
     /// @param pair The LengthPair you want the width from.
     /// @param unit_type Harmonia unit you want the width to be in.
@@ -174,19 +314,91 @@ public:
     /// @return Height in the specified unit you want.
     double get_height_length_pair_unit(LengthPair pair, Harmonia::Unit unit_type);
 
-    /// @brief Updates the container presentation/view in runtime
+    /// @brief Gets sizes the length pairs of this container are converted with, parent size (or window size for root) and window size.
+    UnitContext get_unit_context();
+
+    /// @brief Layout node of this container, the Godot independent input and output of the LayoutSolver.
+    /// @note Length pairs are synced into it before solving, see sync_layout_node()
+    LayoutNode layout_node;
+    /// @brief Layout nodes of plain Control children, rebuilt with each layout of this container.
+    std::vector<LayoutNode> control_layout_nodes;
+
+    /// @brief Converts a LengthPair into a Godot independent layout length.
+    static LayoutNode::Length to_layout_length(const LengthPair& pair);
+    /// @brief Converts grid tracks into layout lengths, reuses the memory of the target.
+    static void to_layout_tracks(const std::vector<LengthPair>& tracks, std::vector<LayoutNode::Length>& target);
+    /// @brief Parses space separated length pairs of grid tracks, 'auto' tracks are NOT_SET. Invalid tracks are reported.
+    void parse_tracks(String tracks_str, std::vector<LengthPair>& tracks, const char* property);
+    /// @brief Parses the length of a property, strings that aren't a number with a unit are reported.
+    /// @note Empty strings unset the length without a report. Invalid strings still give the pair of LengthPair::get_pair.
+    /// @param property Name of the property for the report
+    LengthPair parse_length(const String& value, const char* property);
+    /// @brief Copies length pairs, positioning, visibility and scroll of this container into its layout node.
+    void sync_layout_node();
+    /// @brief Syncs this container and rebuilds children of its layout node from the provided nodes.
+    /// @param children Children laid out by this container (see get_layout_children)
+    void sync_layout_children(const TypedArray<Node>& children);
+
+    /// @brief Gets pixel values of all length pairs of this container, resolves them only when the cache is out of date.
+    /// @return Cached pixel width, height, paddings, margins and positions.
+    const LayoutNode::Geometry& get_resolved_geometry();
+
+    /// @brief Invalidates the cached resolved geometry, which happens when own pairs, parent size or window size change.
+    /// @param include_children Should containers below this one be invalidated too (when size of this container might have changed)
+    void invalidate_geometry(bool include_children = false);
+
+    /// @brief Updates the container presentation/view in runtime, runs a full layout pass from the root container.
     void update_presentation();
 
     /// @brief Self positioning, gets called when there is no parent
     void update_self_position();
 
-    /// @brief Updates the container children positions in runtime
+    /// @brief Applies positions calculated by the layout solver to the children
     void update_children_position(TypedArray<Node> children);
 
     /// @brief Updates a child control node anchors based on this container, for example enforces min/max values for anchors
     /// @param control The child control taht anchors should be updated on.
     void update_control_anchors(Control* control);
 
+    /// NOTE: Layout profiling, enabled for all containers at once. Profiles are kept until reset.
+
+    /// @brief Layout work of this container, only recorded while profiling.
+    LayoutProfile layout_profile;
+    static void set_layout_profiling(bool value);
+    static bool is_layout_profiling();
+    /// @brief Gets the profile of this container, with the totals of this container and its descendants in "subtree".
+    Dictionary get_layout_profile();
+    /// @brief Gets profiles of this container and its descendants, the slowest (own layout time) first.
+    /// @param limit Maximum number of profiles, -1 for all
+    /// @return Profiles (see get_layout_profile) with the "container" they are of.
+    Array get_layout_hotspots(int limit = 10);
+    /// @brief Clears the profiles of this container and its descendants.
+    void reset_layout_profile();
+    void add_subtree_profiles(LayoutProfile& total);
+    void collect_profiled_containers(std::vector<std::pair<uint64_t, ContainerBox*>>& containers);
+
+    /// NOTE: Layout updates, changes between begin_layout_update() and commit_layout_update() send a single merged alert
+    /// and relayout and redraw once at the commit. Updates can be nested, only the outermost commit applies them.
+
+    /// @brief Depth of nested layout updates, 0 when outside of one.
+    int layout_update_depth {0};
+    /// @brief Bits of layout changes made during the current update (see AlertLayoutChange::changed_mask)
+    int pending_layout_changes {0};
+    /// @brief Should the background be redrawn at the commit.
+    bool pending_layout_redraw {false};
+    /// @brief Starts a layout update, alerts and redraws are held until the matching commit.
+    void begin_layout_update();
+    /// @brief Ends a layout update, the outermost commit relayouts the tree, redraws and sends one alert with all changes.
+    void commit_layout_update();
+    /// @brief Is a layout update in progress.
+    bool is_layout_updating();
+    /// @brief Alerts a layout change of this container, held and merged during a layout update.
+    /// @param changed What was changed
+    /// @param redraw Should the background be redrawn
+    void alert_layout_change(AlertLayoutChange::LayoutChanged changed, bool redraw = false);
+    /// @brief Dispatches a layout change alert carrying all provided changes.
+    void dispatch_layout_change(int changed_mask);
+
     /// @brief Alert manager of this containers. Bind to this manager if you want to react to this containers alerts
     AlertManager* alert_manager = nullptr;
     /// @brief A simple getter for alert manager of this container
@@ -194,6 +406,20 @@ public:
     /// @brief A simple setter for alert manager of this container
     void set_alert_manager(AlertManager* manager);
 
+    /// NOTE: Scoped alerts, alerts of a container bubble up its ContainerBox parents before reaching the alert manager.
+    /// Listening on a container hears only its subtree, and a listener can stop the propagation (see Alert::stop_propagation)
+
+    /// @brief Listeners of this containers subtree, created with the first listener.
+    AlertManager* scoped_alerts = nullptr;
+    /// @brief Gets the manager holding the listeners of this subtree, creates it when missing. C++ handlers bind to it directly.
+    AlertManager* get_scoped_alerts();
+    /// @brief Listens to alerts of a type sent by this container or its descendants.
+    void add_alert_listener(String alert_type, Callable callable);
+    void remove_alert_listener(String alert_type, Callable callable);
+    /// @brief Calls the listeners of this container and then of each parent, until one of them stops the propagation.
+    /// @return Was the propagation stopped
+    bool bubble_alert(Alert* alert);
+
     /// @brief ContainerBox parent of this container, only ContainerBox classes are set.
     ContainerBox* parent = nullptr;
 
@@ -344,6 +570,114 @@ public:
     /// @brief Getter for an overflowing behaviour of xy axes
     Harmonia::OverflowBehaviour get_overflow_behaviour();
 
+    /// @brief How children of this container are laid out. Default LAYOUT_BLOCK.
+    Harmonia::LayoutMode layout_mode {Harmonia::LayoutMode::LAYOUT_BLOCK};
+    /// @brief Sets the layout mode of this containers children.
+    void set_layout_mode(Harmonia::LayoutMode new_mode);
+    /// @brief Returns the layout mode of this containers children.
+    Harmonia::LayoutMode get_layout_mode();
+
+    /// @brief Column tracks of this container in grid layout mode, parsed from grid_columns_str.
+    std::vector<LengthPair> grid_columns;
+    /// @brief Space separated column tracks, ex: '100px 1fr 2fr'. Tracks without a unit (ex: 'auto') fit their widest cell.
+    String grid_columns_str;
+    /// @brief Sets the column tracks from their string representation.
+    void set_grid_columns_str(String tracks);
+    /// @brief Gets the string representation of the column tracks.
+    String get_grid_columns_str();
+
+    /// @brief Row tracks of this container in grid layout mode, parsed from grid_rows_str.
+    std::vector<LengthPair> grid_rows;
+    /// @brief Space separated row tracks, ex: '50px 1fr'. Tracks without a unit and rows past the defined ones fit their tallest cell.
+    String grid_rows_str;
+    /// @brief Sets the row tracks from their string representation.
+    void set_grid_rows_str(String tracks);
+    /// @brief Gets the string representation of the row tracks.
+    String get_grid_rows_str();
+
+    /// @brief Main axis of this container in flex layout mode. Default FLEX_ROW.
+    Harmonia::FlexDirection flex_direction {Harmonia::FlexDirection::FLEX_ROW};
+    /// @brief Sets the main axis (and its direction) of this container in flex layout mode.
+    void set_flex_direction(Harmonia::FlexDirection new_direction);
+    /// @brief Returns the main axis of this container in flex layout mode.
+    Harmonia::FlexDirection get_flex_direction();
+
+    /// @brief Whether children that do not fit should go to a new line in flex layout mode. Default FLEX_NO_WRAP.
+    Harmonia::FlexWrap flex_wrap {Harmonia::FlexWrap::FLEX_NO_WRAP};
+    /// @brief Sets the line breaking of this container in flex layout mode.
+    void set_flex_wrap(Harmonia::FlexWrap new_wrap);
+    /// @brief Returns the line breaking of this container in flex layout mode.
+    Harmonia::FlexWrap get_flex_wrap();
+
+    /// @brief Distribution of free space on the main axis in flex layout mode. Default JUSTIFY_START.
+    Harmonia::FlexJustify justify_content {Harmonia::FlexJustify::JUSTIFY_START};
+    /// @brief Sets the distribution of free space on the main axis in flex layout mode.
+    void set_justify_content(Harmonia::FlexJustify new_justify);
+    /// @brief Returns the distribution of free space on the main axis in flex layout mode.
+    Harmonia::FlexJustify get_justify_content();
+
+    /// @brief Alignment of children on the cross axis in flex layout mode. Default ALIGN_STRETCH.
+    /// @note Stretch only applies to children without a set cross size (height for rows, width for columns).
+    Harmonia::FlexAlign align_items {Harmonia::FlexAlign::ALIGN_STRETCH};
+    /// @brief Sets the alignment of children on the cross axis in flex layout mode.
+    void set_align_items(Harmonia::FlexAlign new_align);
+    /// @brief Returns the alignment of children on the cross axis in flex layout mode.
+    Harmonia::FlexAlign get_align_items();
+
+    /// @brief Gap between rows in flex and grid layout modes, percentages are of this containers height.
+    LengthPair row_gap;
+    /// @brief String representation of the row gap, ex: '10px'
+    String row_gap_str;
+    /// @brief Row gap setter in harmonia units.
+    void set_row_gap(double length, Harmonia::Unit unit_type = Harmonia::Unit::PIXEL);
+    /// @brief Retrieves the row gap in a provided unit.
+    double get_row_gap(Harmonia::Unit unit_type = Harmonia::Unit::PIXEL);
+    /// @brief Sets the row gap from a string representation, ex: '10px', '5%'
+    void set_row_gap_str(String length_and_unit);
+    /// @brief Gets the string representation of the row gap.
+    String get_row_gap_str();
+
+    /// @brief Gap between columns in flex and grid layout modes, percentages are of this containers width.
+    LengthPair column_gap;
+    /// @brief String representation of the column gap, ex: '10px'
+    String column_gap_str;
+    /// @brief Column gap setter in harmonia units.
+    void set_column_gap(double length, Harmonia::Unit unit_type = Harmonia::Unit::PIXEL);
+    /// @brief Retrieves the column gap in a provided unit.
+    double get_column_gap(Harmonia::Unit unit_type = Harmonia::Unit::PIXEL);
+    /// @brief Sets the column gap from a string representation, ex: '10px', '5%'
+    void set_column_gap_str(String length_and_unit);
+    /// @brief Gets the string representation of the column gap.
+    String get_column_gap_str();
+
+    /// @brief Share of the free main axis space this container takes when its parent is a flex container. Default 0.
+    double flex_grow {0};
+    /// @brief Simple setter for flex grow, negative values are clamped to 0.
+    void set_flex_grow(double new_grow);
+    /// @brief Simple getter for flex grow.
+    double get_flex_grow();
+
+    /// @brief How much this container shrinks when its flex parent overflows, weighted by its base size. Default 1.
+    double flex_shrink {1};
+    /// @brief Simple setter for flex shrink, negative values are clamped to 0.
+    void set_flex_shrink(double new_shrink);
+    /// @brief Simple getter for flex shrink.
+    double get_flex_shrink();
+
+    /// @brief Base main axis size of this container in a flex parent, when not set width (rows) or height (columns) is used.
+    /// @note Percentages are of the parents main axis size.
+    LengthPair flex_basis;
+    /// @brief String representation of flex basis, ex: '100px', '25%'
+    String flex_basis_str;
+    /// @brief Flex basis setter in harmonia units.
+    void set_flex_basis(double length, Harmonia::Unit unit_type = Harmonia::Unit::PIXEL);
+    /// @brief Retrieves flex basis in a provided unit.
+    double get_flex_basis(Harmonia::Unit unit_type = Harmonia::Unit::PIXEL);
+    /// @brief Sets flex basis from a string representation, ex: '100px', '25%'
+    void set_flex_basis_str(String length_and_unit);
+    /// @brief Gets the string representation of flex basis.
+    String get_flex_basis_str();
+
     /// NOTE: BELOW Str pos are positions set in the editor or in the code using getter/setter
     /// The string positions get processed to create a pos_x length pair. Ex of str pos: 10%, 10px
 
@@ -454,4 +788,27 @@ protected:
 	bool _get(const StringName &p_name, Variant &r_ret) const;
     void _get_property_list(List<PropertyInfo> *p_list) const;
     void _notification(int p_what);
-};
\ No newline at end of file
+};
+
+/// @brief Scoped layout update of a container, begins on construction and commits on destruction.
+/// @note Ex: { LayoutUpdateScope update(container); container->set_width(...); container->set_padding_all(...); }
+class LayoutUpdateScope
+{
+public:
+    explicit LayoutUpdateScope(ContainerBox* container);
+    ~LayoutUpdateScope();
+    LayoutUpdateScope(const LayoutUpdateScope&) = delete;
+    LayoutUpdateScope& operator=(const LayoutUpdateScope&) = delete;
+private:
+    ContainerBox* container;
+};
+
+inline LayoutUpdateScope::LayoutUpdateScope(ContainerBox* container) : container(container)
+{
+    container->begin_layout_update();
+}
+
+inline LayoutUpdateScope::~LayoutUpdateScope()
+{
+    container->commit_layout_update();
+}
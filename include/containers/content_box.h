@@ -5,7 +5,12 @@
 #include <godot_cpp/classes/control.hpp>
 #include <godot_cpp/classes/v_scroll_bar.hpp>
 #include <godot_cpp/classes/h_scroll_bar.hpp>
+#include <godot_cpp/classes/packed_scene.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
 #include "core/harmonia.h"
+#include "core/layout/virtual_list.h"
+#include <vector>
 
 using namespace godot;
 
@@ -60,6 +65,19 @@ public:
     /// @brief How much should all content be offsetted by? (when negative overflow) (can be used by container to offset it there)
     double offset_top_px {0};
 
+    /// @brief Position of this box without the scroll, set by the parent ContainerBox (standalone boxes take their position when ready)
+    Vector2 scroll_origin;
+    /// @brief Sets the unscrolled position of this box and applies the current scroll to it.
+    void set_scroll_origin(Vector2 origin);
+    /// @brief Is the unscrolled area clipped, see apply_overflowing
+    bool clipping {false};
+    /// @brief Moves this box by the scroll, children keep their unscrolled positions so a scroll is a single transform update.
+    /// @note The clip stays on the unscrolled area through a custom canvas item rect.
+    void apply_scroll_offset();
+    /// @brief Sets the custom rect and clip of the canvas item to the unscrolled area.
+    /// @note Control resets both on every draw, so it's applied again in NOTIFICATION_DRAW.
+    void apply_scroll_clip();
+
     /// @brief Applies scrolling by steps
     /// @param step_x The movement on x axis
     /// @param step_y The movement on y axis
@@ -73,7 +91,137 @@ public:
     /// @brief Calculates overflowing based on child_pos, child_size and parent size
     double calculate_overflowing(double child_pos, double child_size, double parent_size);
 
+    /// NOTE: Kinetic scrolling, input adds velocity and the scroll is integrated once per frame (processing runs only while moving).
+
+    /// @brief Should wheel and pan input scroll kinetically, when false every wheel event scrolls by a step immediately.
+    bool smooth_scrolling {true};
+    /// @brief Sets kinetic scrolling, turning it off stops the current animation.
+    void set_smooth_scrolling(bool value);
+    /// @brief Simple getter for kinetic scrolling.
+    bool get_smooth_scrolling();
+
+    /// @brief How fast the scroll velocity decays, per second (exponential). Higher stops sooner.
+    /// @note A wheel step scrolls roughly by its step size in total whatever the friction.
+    double scroll_friction {10};
+    /// @brief Sets the scroll friction, clamped to a small positive value.
+    void set_scroll_friction(double value);
+    /// @brief Simple getter for the scroll friction.
+    double get_scroll_friction();
+
+    /// @brief Current scroll velocity in px/s, positive moves content right/down (same as apply_scrolling steps)
+    Vector2 scroll_velocity;
+    /// @brief Adds velocity to the scroll animation and starts it.
+    /// @param velocity Velocity in px/s
+    void add_scroll_velocity(Vector2 velocity);
+    /// @brief Cancels the scroll animation, the scroll stays where it is.
+    void stop_scroll_animation();
+    /// @brief Is the scroll animation running.
+    bool is_scroll_animating();
+    /// @brief Integrates the scroll velocity, a single scroll update per frame.
+    void _process(double delta) override;
+
     void _gui_input(const Ref<InputEvent> &p_gui_input);
+    /// @brief Only the visible (unscrolled) area of this box receives input.
+    bool _has_point(const Vector2 &p_point) const override;
+
+    /// NOTE: Virtualization, only items intersecting the view (plus overscan) exist as live controls, they get recycled through a pool.
+    /// Items are stacked from top to bottom and take the full width of this box, their sizes come from the size provider or the estimate.
+
+    /// @brief Is this box virtualized, when true its content are item_count items instantiated from item_scene instead of its own children.
+    bool virtualized {false};
+    /// @brief Sets virtualization, turning it off frees all items.
+    void set_virtualized(bool value);
+    /// @brief Simple getter for virtualization.
+    bool get_virtualized();
+
+    /// @brief Number of items of the virtualized list.
+    int item_count {0};
+    /// @brief Sets the number of items, sizes get requested again and visible items rebound.
+    void set_item_count(int count);
+    /// @brief Simple getter for the number of items.
+    int get_item_count();
+
+    /// @brief Scene of the items, its root has to be a Control.
+    Ref<PackedScene> item_scene;
+    /// @brief Sets the scene of the items, frees existing items.
+    void set_item_scene(const Ref<PackedScene>& scene);
+    /// @brief Simple getter for the scene of the items.
+    Ref<PackedScene> get_item_scene();
+
+    /// @brief Called as (item: Control, index: int) when an item gets (re)used for an index.
+    Callable item_binder;
+    /// @brief Sets the item binder, visible items get rebound.
+    void set_item_binder(const Callable& binder);
+    /// @brief Simple getter for the item binder.
+    Callable get_item_binder();
+
+    /// @brief Called as (index: int) -> float, returns height of an item in px. When not valid the estimate is used for every item.
+    /// @note Called for every item when the sizes are refreshed (count change or refresh_items), not while scrolling.
+    Callable item_size_provider;
+    /// @brief Sets the item size provider, sizes get requested again.
+    void set_item_size_provider(const Callable& provider);
+    /// @brief Simple getter for the item size provider.
+    Callable get_item_size_provider();
+
+    /// @brief Height of items in px without a size from the size provider.
+    double estimated_item_size {32};
+    /// @brief Sets the estimated height of items in px.
+    void set_estimated_item_size(double size);
+    /// @brief Simple getter for the estimated height of items.
+    double get_estimated_item_size();
+
+    /// @brief Distance in px above and below the view in which items are kept alive, avoids pop in while scrolling.
+    double overscan_px {64};
+    /// @brief Sets the overscan distance in px.
+    void set_overscan_px(double value);
+    /// @brief Simple getter for the overscan distance.
+    double get_overscan_px();
+
+    /// @brief Sets height of a single item, ex. after its content changed. Keeps the scroll extents correct without a full refresh.
+    /// @note Extents of the following items are summed again at the next update (once per frame), O(n) for items near the top.
+    void set_item_size(int index, double size);
+    /// @brief Gets height of a single item.
+    double get_item_size(int index);
+
+    /// @brief Requests all sizes again and rebinds the visible items.
+    void refresh_items();
+
+    /// @brief Updates scroll extents, materializes the items intersecting the view and positions them.
+    /// @note Cost depends on the visible items, not on item_count (except after refresh which requests all sizes).
+    void update_virtual_items();
+
+    /// @brief Gets the currently materialized items, ordered by their index.
+    TypedArray<Control> get_active_items();
+    /// @brief Gets the index of the first materialized item.
+    int get_first_active_index();
+
+private:
+    /// @brief Item sizes and offsets of the virtualized list
+    VirtualList virtual_list;
+    /// @brief Materialized items, active_items[i] shows the item active_first + i
+    std::vector<Control*> active_items;
+    size_t active_first {0};
+    /// @brief Scratch for swapping the materialized items, kept to avoid allocating while scrolling.
+    std::vector<Control*> next_active_items;
+    /// @brief Released items, hidden but still inside of the tree.
+    std::vector<Control*> item_pool;
+    /// @brief Should sizes be requested again on the next update
+    bool item_sizes_dirty {true};
+    /// @brief Should every visible item be bound again on the next update
+    bool items_rebind {true};
+    /// @brief Is an update already waiting for the end of the frame
+    bool virtual_update_queued {false};
+
+    /// @brief Schedules update_virtual_items, through the parent ContainerBox layout when inside of one.
+    void queue_virtual_update();
+    /// @brief Deferred part of queue_virtual_update.
+    void flush_virtual_update();
+    /// @brief Takes an item from the pool or instantiates a new one.
+    Control* acquire_item();
+    /// @brief Hides an item and returns it to the pool.
+    void release_item(Control* item);
+    /// @brief Frees all items, active and pooled.
+    void clear_items();
 protected:
     static void _bind_methods();
 	bool _set(const StringName &p_name, const Variant &p_value);
@@ -4,6 +4,7 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/godot.hpp>
+#include "commons/length_parser.h"
 
 using namespace godot;
 
@@ -48,6 +49,56 @@ public:
         VIEWPORT_WIDTH,
         /// @brief This is a viewport height unit, written short 'vh' in values, ex: '10vh'
         VIEWPORT_HEIGHT,
+        /// @brief This is a fraction unit, a share of the free space of grid tracks, written short 'fr' in values, ex: '1fr'
+        /// @note Only grid tracks use it, anywhere else it converts to 0.
+        FRACTION,
+    };
+
+    /// @brief Enum used for the layout mode of containers, how children of a container get sized and positioned.
+    enum LayoutMode {
+        LAYOUT_BLOCK, // Normal, children are stacked from top to bottom
+        LAYOUT_FLEX, // Children are laid out in rows or columns, see FlexDirection
+        LAYOUT_GRID, // Children are placed row by row into grid column and row tracks
+    };
+
+    /// @brief Enum used for the main axis of flex containers.
+    enum FlexDirection {
+        FLEX_ROW, // Left to right
+        FLEX_ROW_REVERSE, // Right to left
+        FLEX_COLUMN, // Top to bottom
+        FLEX_COLUMN_REVERSE, // Bottom to top
+    };
+
+    /// @brief Enum used for line breaking of flex containers.
+    enum FlexWrap {
+        FLEX_NO_WRAP, // Single line, items shrink or overflow
+        FLEX_WRAP, // Items that do not fit go to a new line
+    };
+
+    /// @brief Enum used for distributing free space along the main axis of flex containers.
+    enum FlexJustify {
+        JUSTIFY_START,
+        JUSTIFY_END,
+        JUSTIFY_CENTER,
+        JUSTIFY_SPACE_BETWEEN, // Free space between items, none at the edges
+        JUSTIFY_SPACE_AROUND, // Free space around items, half of it at the edges
+        JUSTIFY_SPACE_EVENLY, // Same free space between items and at the edges
+    };
+
+    /// @brief Enum used for aligning items on the cross axis of flex containers.
+    enum FlexAlign {
+        ALIGN_START,
+        ALIGN_END,
+        ALIGN_CENTER,
+        ALIGN_STRETCH, // Items without a set cross size fill the line
+    };
+
+    /// @brief Enum used for the part of a scrollable container that is under a picked point.
+    enum PickRegion {
+        PICK_NONE, // No scrollable container under the point
+        PICK_CONTENT,
+        PICK_VERTICAL_SCROLLBAR,
+        PICK_HORIZONTAL_SCROLLBAR, // Includes the checking area above the scrollbar
     };
 
     //const static String ALERT_LAYOUT_CHANGE; // "layout-change"
@@ -75,8 +126,20 @@ struct LengthPair{
 
     /// @brief Gets a length pair from a string representation of that pair
     /// @param string_pair The string pair representation
-    /// @return Converted length pair
-    static LengthPair get_pair(String string_pair);
+    /// @return Converted length pair, the unit is NOT_SET unless the string ends with a known unit. A unit without a number
+    /// keeps its unit with length 0 (ex. "px" is 0 PIXEL), see parse() for telling invalid strings apart
+    static LengthPair get_pair(const String& string_pair);
+
+    /// @brief Parses a string representation of a length pair, without allocating.
+    /// @param string_pair The string pair representation
+    /// @param pair Set to the parsed pair, also when parsing fails (the same pair get_pair() returns)
+    /// @return Status of parsing, LengthParser::PARSE_OK if the string was a number with a known unit
+    static LengthParser::Status parse(const String& string_pair, LengthPair& pair);
+
+    /// @brief Gets a description of why a string wasn't a valid length, for reporting invalid property values.
+    /// @param status Status returned by parse()
+    /// @return Description of the status, empty for PARSE_OK
+    static String get_parse_error(LengthParser::Status status);
 
     /// @brief Gets a int unit from provided string unit representation;
     /// @param unit_string String unit representation
@@ -92,4 +155,10 @@ struct LengthPair{
 VARIANT_ENUM_CAST(Harmonia::OverflowBehaviour)
 VARIANT_ENUM_CAST(Harmonia::Position)
 VARIANT_ENUM_CAST(Harmonia::Unit)
-VARIANT_ENUM_CAST(Harmonia::Visibility)
\ No newline at end of file
+VARIANT_ENUM_CAST(Harmonia::Visibility)
+VARIANT_ENUM_CAST(Harmonia::LayoutMode)
+VARIANT_ENUM_CAST(Harmonia::FlexDirection)
+VARIANT_ENUM_CAST(Harmonia::FlexWrap)
+VARIANT_ENUM_CAST(Harmonia::FlexJustify)
+VARIANT_ENUM_CAST(Harmonia::FlexAlign)
+VARIANT_ENUM_CAST(Harmonia::PickRegion)
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <vector>
+
+/// @brief Godot independent node of the layout tree. Holds layout inputs of a container or control and the results of the LayoutSolver.
+///
+/// ContainerBox keeps one of these and syncs its length pairs into it, which allows running (and measuring) layout without the engine.
+class LayoutNode
+{
+public:
+    LayoutNode() = default;
+    ~LayoutNode() = default;
+
+    /// @brief Units of layout lengths, values match Harmonia::Unit
+    enum Unit {
+        NOT_SET = -1,
+        PIXEL,
+        PERCENTAGE,
+        VIEWPORT_WIDTH,
+        VIEWPORT_HEIGHT,
+        /// @brief Share of the free space, only meaningful for grid tracks and converts to 0 elsewhere.
+        FRACTION,
+    };
+
+    /// @brief Positioning of the node inside of its parent, values match Harmonia::Position
+    enum Position {
+        STATIC,
+        ABSOLUTE,
+        RELATIVE,
+    };
+
+    /// @brief How a container lays out its children, values match Harmonia::LayoutMode
+    enum LayoutMode {
+        LAYOUT_BLOCK,
+        LAYOUT_FLEX,
+        LAYOUT_GRID,
+    };
+
+    /// @brief Main axis of a flex container, values match Harmonia::FlexDirection
+    enum FlexDirection {
+        FLEX_ROW,
+        FLEX_ROW_REVERSE,
+        FLEX_COLUMN,
+        FLEX_COLUMN_REVERSE,
+    };
+
+    /// @brief Line breaking of a flex container, values match Harmonia::FlexWrap
+    enum FlexWrap {
+        FLEX_NO_WRAP,
+        FLEX_WRAP,
+    };
+
+    /// @brief Distribution of free main axis space in flex lines, values match Harmonia::FlexJustify
+    enum FlexJustify {
+        JUSTIFY_START,
+        JUSTIFY_END,
+        JUSTIFY_CENTER,
+        JUSTIFY_SPACE_BETWEEN,
+        JUSTIFY_SPACE_AROUND,
+        JUSTIFY_SPACE_EVENLY,
+    };
+
+    /// @brief Cross axis alignment of items in flex lines, values match Harmonia::FlexAlign
+    enum FlexAlign {
+        ALIGN_START,
+        ALIGN_END,
+        ALIGN_CENTER,
+        ALIGN_STRETCH,
+    };
+
+    /// @brief What the node represents, containers size and lay out their children, controls only get positioned.
+    enum Kind {
+        CONTAINER,
+        CONTROL,
+    };
+
+    /// @brief Length and unit of a layout value, Godot independent equivalent of LengthPair
+    /// @note % are actual percentages in length, ex. 10% is 0.1
+    struct Length {
+        Unit unit_type {NOT_SET};
+        double length {0};
+    };
+
+    /// @brief Pixel values of the lengths, resolved against the parent size and the viewport size.
+    struct Geometry {
+        double width {0};
+        double height {0};
+        double padding_up {0};
+        double padding_right {0};
+        double padding_down {0};
+        double padding_left {0};
+        double margin_up {0};
+        double margin_right {0};
+        double margin_down {0};
+        double margin_left {0};
+        double pos_x {0};
+        double pos_y {0};
+    };
+
+    /// NOTE: Inputs, set by the owner of the node before solving.
+
+    Kind kind {CONTAINER};
+    Position position_type {STATIC};
+    /// @brief Hidden nodes get no space allocated and are skipped by the solver.
+    bool hidden {false};
+    /// @brief Controls with anchors set are positioned without the parents left padding (see ContainerBox::update_control_anchors)
+    bool anchored {false};
+    /// @brief Are children laid out inside of a scrolled content area (content box with SCROLL overflow)
+    /// @note Positions are unscrolled, the content area itself gets moved by the scroll.
+    bool scroll_content {false};
+
+    /// @brief How children of this node are laid out.
+    LayoutMode layout_mode {LAYOUT_BLOCK};
+    FlexDirection flex_direction {FLEX_ROW};
+    FlexWrap flex_wrap {FLEX_NO_WRAP};
+    FlexJustify justify_content {JUSTIFY_START};
+    /// @brief Stretch applies only to items without a cross axis length (NOT_SET)
+    FlexAlign align_items {ALIGN_STRETCH};
+    /// @brief Gap between rows (flex lines of a row container, items of a column container), % of own height.
+    Length row_gap;
+    /// @brief Gap between columns (items of a row container, flex lines of a column container), % of own width.
+    Length column_gap;
+
+    /// @brief Column tracks of a grid container, % of own width, FRACTION share the free width, NOT_SET fit the widest cell.
+    std::vector<Length> grid_columns;
+    /// @brief Row tracks of a grid container, % of own height, FRACTION share the free height, NOT_SET fit the tallest cell.
+    /// @note Rows past the defined ones (implicit rows) fit the tallest cell.
+    std::vector<Length> grid_rows;
+
+    /// @brief Share of the free main axis space this node grows by inside of a flex container.
+    double flex_grow {0};
+    /// @brief Share of the missing main axis space this node shrinks by inside of a flex container, weighted by its basis.
+    double flex_shrink {1};
+    /// @brief Initial main axis size inside of a flex container, NOT_SET uses width or height. % of the container main size.
+    Length flex_basis;
+
+    Length width;
+    Length height;
+    Length padding_up;
+    Length padding_right;
+    Length padding_down;
+    Length padding_left;
+    Length margin_up;
+    Length margin_right;
+    Length margin_down;
+    Length margin_left;
+    Length pos_x;
+    Length pos_y;
+
+    /// NOTE: Tree, nodes don't own each other. Owner keeps the nodes alive.
+
+    LayoutNode* parent {nullptr};
+    std::vector<LayoutNode*> children;
+
+    /// NOTE: Outputs, set by the LayoutSolver.
+
+    /// @brief Cached resolved pixel values of the lengths.
+    Geometry geometry;
+    /// @brief Should the geometry be resolved again, set when any of the lengths change.
+    bool geometry_dirty {true};
+    /// @brief Parent width the geometry was resolved against.
+    double resolved_parent_width {-1};
+    /// @brief Parent height the geometry was resolved against.
+    double resolved_parent_height {-1};
+    /// @brief Viewport width the geometry was resolved against.
+    double resolved_viewport_width {-1};
+    /// @brief Viewport height the geometry was resolved against.
+    double resolved_viewport_height {-1};
+
+    /// @brief Width with paddings (px)
+    double total_width {0};
+    /// @brief Height with paddings (px)
+    double total_height {0};
+
+    /// @brief Position on X axis, relative to the content origin of the parent (px)
+    double position_x {0};
+    /// @brief Position on Y axis, relative to the content origin of the parent (px)
+    double position_y {0};
+
+    bool is_overflowed_x {false};
+    bool is_overflowed_y {false};
+    /// @brief Size of X overflowing (px), includes negative overflow.
+    double overflow_x {0};
+    /// @brief Size of Y overflowing (px), includes negative overflow.
+    double overflow_y {0};
+    /// @brief Negative overflow on X axis specifically LEFT (px)
+    double negative_overflow_x {0};
+    /// @brief Negative overflow on Y axis specifically TOP (px)
+    double negative_overflow_y {0};
+    /// @brief How much children are offsetted by on X axis due to negative overflow (px)
+    double content_offset_x {0};
+    /// @brief How much children are offsetted by on Y axis due to negative overflow (px)
+    double content_offset_y {0};
+
+    /// @brief Adds a child at the end and sets its parent.
+    void add_child(LayoutNode* child);
+    /// @brief Removes all children, doesn't change the parent of the removed children.
+    void clear_children();
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/layout/layout_node.h"
+
+/// @brief Godot independent layout engine. Resolves lengths of LayoutNodes into pixels, sizes them, calculates overflows and positions children.
+///
+/// All functions are static, the viewport size (root window size) is passed to every pass.
+class LayoutSolver
+{
+public:
+    LayoutSolver() = default;
+    ~LayoutSolver() = default;
+
+    /// @brief Converts a length into pixels.
+    /// @param length Length and unit
+    /// @param parent_size Same axis size of the parent, base of percentages
+    /// @param viewport_width Viewport width, base of vw
+    /// @param viewport_height Viewport height, base of vh
+    /// @return Length in pixels, 0 for unknown units
+    static double to_pixels(const LayoutNode::Length& length, double parent_size, double viewport_width, double viewport_height);
+
+    /// @brief Resolves all lengths of a node into pixels, regardless of the cache state.
+    static void resolve_geometry(LayoutNode& node, double parent_width, double parent_height, double viewport_width, double viewport_height);
+
+    /// @brief Resolves lengths of a node into pixels only when they or the bases they were resolved against changed.
+    /// @return Has the geometry been resolved again
+    static bool update_geometry(LayoutNode& node, double parent_width, double parent_height, double viewport_width, double viewport_height);
+
+    /// @brief Calculates overflow from provided same axis container size, check size and current overflow
+    /// @param container Size of the container
+    /// @param check_size Size of the checking size
+    /// @param current_overflow The current overflow
+    /// @return Overflow or current overflow if calculated is not bigger
+    static double calculate_overflow(double container, double check_size, double current_overflow);
+
+    /// @brief Calculates overflows of a node from its children, children geometry has to be resolved.
+    static void update_overflows(LayoutNode& node);
+
+    /// @brief Positions a node without a parent (root) by its margins and positions.
+    static void update_self_position(LayoutNode& node);
+
+    /// @brief Positions children of a node, uses offsets calculated by update_overflows.
+    static void update_children_position(LayoutNode& node);
+
+    /// @brief Calculates overflows of a node from extents of its positioned children, positions have to be relative to the content origin.
+    /// @note Used by the flex and grid layouts, block layout measures overflow by stacking (see update_overflows)
+    static void update_overflows_from_extents(LayoutNode& node);
+
+    /// @brief Sizes and positions children of a flex container in a single linear pass, lines are broken, grown/shrunk, justified and aligned.
+    /// @note Grown, shrunk and stretched items get their resolved width or height overridden.
+    static void update_flex(LayoutNode& node, double viewport_width, double viewport_height);
+
+    /// @brief Sizes and positions children of a grid container, children are auto-placed row by row into the column tracks.
+    /// @note Solved in O(cells + tracks), children without a set width or height stretch to their cell.
+    static void update_grid(LayoutNode& node, double viewport_width, double viewport_height);
+
+    /// @brief Lays out a single node: resolves its and its childrens geometry, sizes it, calculates overflows and positions its children.
+    /// @note Doesn't walk down, parents have to be laid out before their children.
+    static void layout(LayoutNode& node, double viewport_width, double viewport_height);
+
+    /// @brief Lays out a whole tree top-down in a single pass, each node is visited once.
+    static void solve(LayoutNode& root, double viewport_width, double viewport_height);
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Godot independent index of resolved container rects, answers which container and which scrollable container is under a point.
+///
+/// Rects are grouped into scopes, one for the root and one for the content of every scrolled container. Each scope has its own
+/// bounding volume hierarchy, and rects are stored unscrolled relative to their scope. Scrolling only moves the origin of a scope
+/// (see set_scope_origin), so the index stays valid until the next layout pass.
+class SpatialIndex
+{
+public:
+    SpatialIndex() = default;
+    ~SpatialIndex() = default;
+
+    /// @brief Part of the scrollable container a point is in, values match Harmonia::PickRegion
+    enum Region {
+        REGION_NONE,
+        REGION_CONTENT,
+        REGION_VERTICAL_SCROLLBAR,
+        REGION_HORIZONTAL_SCROLLBAR,
+    };
+
+    struct Rect {
+        double x {0};
+        double y {0};
+        double width {0};
+        double height {0};
+
+        bool has_point(double point_x, double point_y) const;
+    };
+
+    struct Entry {
+        /// @brief Owner defined id, returned by queries.
+        int id {-1};
+        /// @brief Depth in the container tree, the deepest rect containing a point wins (later entries win ties).
+        int depth {0};
+        /// @brief Rect of the container, relative to its scope.
+        Rect rect;
+        /// @brief Can the container be scrolled (overflowed with SCROLL behaviour), only these are returned as scrollable.
+        bool scrollable {false};
+        /// @brief Scrollbar rects of a scrollable container relative to its scope, empty when hidden.
+        Rect vertical_scrollbar;
+        Rect horizontal_scrollbar;
+        /// @brief Height above the horizontal scrollbar that still counts as its region (px)
+        double horizontal_scrollbar_band {0};
+        /// @brief Scope holding the children of this container, -1 when they are in the same scope.
+        int content_scope {-1};
+    };
+
+    struct Hit {
+        /// @brief Deepest container containing the point, -1 when none.
+        int id {-1};
+        /// @brief Deepest scrollable container containing the point, -1 when none.
+        int scrollable_id {-1};
+        /// @brief Region of the scrollable container the point is in.
+        Region region {REGION_NONE};
+    };
+
+    /// @brief Removes all scopes and entries and adds the root scope (0).
+    void clear();
+
+    /// @brief Adds a scope for the content of a container.
+    /// @return Index of the new scope
+    int add_scope();
+
+    /// @brief Sets where a scope starts in the space of the scope of its container, includes the scroll.
+    /// @note Doesn't need a rebuild, out of range scopes are ignored.
+    void set_scope_origin(int scope, double x, double y);
+
+    /// @brief Adds a container rect, the index has to be rebuilt before querying.
+    void add_entry(int scope, const Entry& entry);
+
+    /// @brief Builds the hierarchies of all scopes.
+    void build();
+
+    /// @brief Finds the deepest container and the deepest scrollable container under a point of the root scope.
+    Hit query(double x, double y) const;
+
+    /// @brief Number of entries.
+    size_t size() const;
+
+private:
+    struct Bounds {
+        double min_x;
+        double min_y;
+        double max_x;
+        double max_y;
+    };
+
+    struct Node {
+        Bounds bounds;
+        /// @brief First child node of an inner node (the second one follows it), -1 for leaves.
+        int left {-1};
+        /// @brief Range of the leaf in the ordered entries.
+        int first {0};
+        int count {0};
+    };
+
+    struct Scope {
+        double origin_x {0};
+        double origin_y {0};
+        /// @brief Root node of the hierarchy, -1 when empty.
+        int root {-1};
+    };
+
+    /// @brief Builds a node over ordered entries [first, first + count), the node has to be allocated already.
+    void build_node(int node, int first, int count);
+
+    /// @brief Gets the entry with the greatest depth containing a point, -1 when none.
+    int find_deepest(const Scope& scope, double x, double y) const;
+
+    std::vector<Entry> entries;
+    std::vector<int> entry_scopes;
+    std::vector<Scope> scopes {Scope()};
+    /// @brief Entry indices grouped by scope, leaves of the hierarchies point into it.
+    std::vector<int> ordered;
+    /// @brief Rects in the order of ordered, leaves test them without touching the entries.
+    std::vector<Rect> ordered_rects;
+    std::vector<Node> nodes;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Batch conversion of lengths into pixels, stored as structure of arrays (units, lengths, parent sizes).
+///
+/// Produces exactly the same values as the scalar conversion (UnitConversion into pixels),
+/// each lane computes every unit and selects the matching one with masks, unknown units give 0.
+/// The SIMD kernel is picked once at runtime from what the CPU supports.
+class UnitBatch
+{
+public:
+    UnitBatch() = default;
+    ~UnitBatch() = default;
+
+    /// @brief Conversion kernels, selected at runtime by get_kernel()
+    enum Kernel {
+        KERNEL_SCALAR,
+        KERNEL_SSE2,
+        KERNEL_AVX2,
+        KERNEL_NEON,
+    };
+
+    /// @brief Converts lengths into pixels.
+    /// @param units Units of the lengths, values of LayoutNode::Unit (same as Harmonia::Unit)
+    /// @param lengths Lengths in their units
+    /// @param parent_sizes Same axis parent sizes, base of percentages
+    /// @param viewport_width Viewport width, base of vw
+    /// @param viewport_height Viewport height, base of vh
+    /// @param results Output pixel values, can't overlap the inputs
+    /// @param count Number of lengths
+    static void to_pixels(const int32_t* units, const double* lengths, const double* parent_sizes,
+        double viewport_width, double viewport_height, double* results, size_t count);
+
+    /// @brief Same as to_pixels() but with an explicitly chosen kernel, the kernel has to be supported.
+    static void to_pixels(Kernel kernel, const int32_t* units, const double* lengths, const double* parent_sizes,
+        double viewport_width, double viewport_height, double* results, size_t count);
+
+    /// @brief Gets the fastest kernel supported by this CPU, detected once.
+    static Kernel get_kernel();
+    /// @brief Is the kernel compiled in and supported by this CPU.
+    static bool is_kernel_supported(Kernel kernel);
+    /// @brief Gets a readable name of the kernel, ex. "avx2"
+    static const char* get_kernel_name(Kernel kernel);
+
+    std::vector<int32_t> units;
+    std::vector<double> lengths;
+    std::vector<double> parent_sizes;
+    std::vector<double> results;
+
+    /// @brief Removes all lengths, keeps the allocated capacity.
+    void clear();
+    /// @brief Resizes all arrays to the count, for filling them directly through data()
+    void resize(size_t count);
+    /// @brief Adds a length to be converted.
+    void push(int32_t unit, double length, double parent_size);
+    /// @brief Converts all added lengths into results, results are sized to the number of lengths.
+    void convert(double viewport_width, double viewport_height);
+    size_t size() const;
+};
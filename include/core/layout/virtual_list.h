@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Godot independent extents of a virtualized list, item sizes along the scrolled axis and their offsets.
+///
+/// Offsets are prefix sums of the sizes, rebuilt lazily from the first changed item. Finding the items inside of a scrolled
+/// view is a binary search, so it depends on the visible items rather than all of them.
+///
+/// Changing the size of an item makes the next query rebuild every offset after it, which is O(n) for items near the top.
+/// Size changes between two queries share one rebuild, so they should be batched (ContentBox queues one update per frame)
+/// rather than interleaved with queries.
+class VirtualList
+{
+public:
+    VirtualList() = default;
+    ~VirtualList() = default;
+
+    /// @brief Changes the item count, kept items keep their sizes and new items get the provided size.
+    /// @param count New item count
+    /// @param size Size of added items (usually an estimate)
+    void resize(size_t count, double size);
+
+    /// @brief Sets the size of every item.
+    void fill(double size);
+
+    /// @brief Sets size of a single item, offsets of the following items get rebuilt on the next query.
+    /// @note The rebuild is linear in the count of following items, see the class description.
+    void set_item_size(size_t index, double size);
+
+    /// @brief Gets size of an item, 0 when out of range.
+    double get_item_size(size_t index) const;
+
+    /// @brief Gets the offset (start) of an item, the item count returns the total size.
+    double get_item_offset(size_t index);
+
+    /// @brief Gets the sum of all item sizes.
+    double get_total_size();
+
+    /// @brief Number of items.
+    size_t size() const;
+
+    /// @brief Gets items intersecting a view.
+    /// @param view_start Start of the view (scrolled distance)
+    /// @param view_size Size of the view
+    /// @param overscan Distance before and after the view that is also included
+    /// @param first Index of the first intersecting item
+    /// @param last Index after the last intersecting item, equal to first when nothing intersects
+    void get_range(double view_start, double view_size, double overscan, size_t& first, size_t& last);
+
+private:
+    /// @brief Rebuilds offsets starting at the first changed item.
+    void update_offsets();
+
+    std::vector<double> sizes;
+    /// @brief Starts of the items, has one more entry than sizes which holds the total size.
+    std::vector<double> offsets {0};
+    /// @brief First item whose offset is out of date, sizes.size() when up to date.
+    size_t dirty_from {0};
+};
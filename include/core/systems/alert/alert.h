@@ -3,6 +3,7 @@
 #include <godot_cpp/godot.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/object_id.hpp>
 
 using namespace godot;
 
@@ -13,10 +14,47 @@ public:
     Alert() = default;
     ~Alert() = default;
     Alert(String name);
+    /// @brief Creates an alert of an already interned type, avoids converting the name.
+    Alert(int type);
      
     String alert_name = "";
     virtual void set_alert_name(String new_name);
     virtual String get_alert_name();
+
+    /// @brief Interned type of this alert, -1 until the name gets interned (see get_alert_type)
+    int alert_type {-1};
+    /// @brief Gets the interned type of this alert, interns the name when it wasn't yet.
+    int get_alert_type();
+
+    /// @brief Object which dispatched this alert, deferred alert managers merge duplicates per sender.
+    ObjectID sender_id;
+    void set_sender(Object* sender);
+    /// @brief Gets the sender, null when it was freed or never set.
+    Object* get_sender() const;
+
+    /// @brief Container whose listeners are handling this alert while it bubbles (see ContainerBox::bubble_alert)
+    ObjectID current_target_id;
+    void set_current_target(Object* target);
+    /// @brief Gets the current target, null outside of bubbling.
+    Object* get_current_target() const;
+
+    /// @brief Was the propagation stopped, listeners of the containers above and the alert manager aren't called.
+    bool propagation_stopped {false};
+    /// @brief Stops bubbling after the listeners of the current target.
+    void stop_propagation();
+    bool is_propagation_stopped() const;
+
+    /// @brief Part of the key deferred alert managers merge duplicates by, besides the sender and the type.
+    /// @note Alerts which describe different things under one type (ex. AlertLayoutChange) return what they describe.
+    virtual int get_merge_key() const;
+
+    /// @brief Interns an alert type name, the same name always gets the same id. Alert managers index their handlers by it.
+    /// @note Thread safe, but takes a lock. Alerts cache their type (see get_alert_type)
+    static int intern_type(const String& name);
+    /// @brief Gets the id of an already interned alert type name, -1 when unknown. Unlike intern_type it never adds the name.
+    static int find_type(const String& name);
+    /// @brief Gets the name of an interned alert type, empty when unknown.
+    static String get_type_name(int type);
 protected:
     static void _bind_methods();
     bool _set(const StringName &p_name, const Variant &p_value);
@@ -27,4 +65,9 @@ protected:
 inline Alert::Alert(String name) : alert_name(name)
 {
     alert_name = name;
-}
\ No newline at end of file
+    alert_type = intern_type(name);
+}
+
+inline Alert::Alert(int type) : alert_name(get_type_name(type)), alert_type(type)
+{
+}
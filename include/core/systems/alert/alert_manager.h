@@ -2,33 +2,188 @@
 
 #include <godot_cpp/godot.hpp>
 #include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <atomic>
 #include <functional>
-#include <unordered_map>
-#include <unordered_set>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "core/systems/alert/alert.h"
  
 using namespace godot;
 
+#ifdef HARMONIA_ALERT_STATS
+/// @brief Call count and latency histogram of alert handlers.
+struct AlertLatencyStats {
+    static constexpr int HISTOGRAM_BUCKETS = 16;
+
+    uint64_t calls {0};
+    uint64_t total_nsec {0};
+    uint64_t max_nsec {0};
+    /// @brief Bucket i counts calls under 2^i microseconds, the last bucket counts the slower ones.
+    uint64_t histogram[HISTOGRAM_BUCKETS] {};
+
+    void record(uint64_t nsec);
+    Dictionary to_dictionary() const;
+};
+#endif
+
+/// @brief Dispatches alerts to the handlers bound to their type.
+///
+/// Handlers are stored in a flat list per interned alert type (see Alert::intern_type), so dispatching is an index and an
+/// iteration without heap allocations. The handler lists are immutable snapshots, binding or unbinding publishes a new
+/// snapshot (copy on write) and a running dispatch keeps iterating the one it started with. Handlers can be bound and
+/// unbound from any thread and while dispatching, added ones get the next alert and removed ones are skipped right away.
+///
+/// In deferred mode alerts are queued instead, duplicates (same sender, type and merge key) are merged into one, and the queue
+/// is flushed once per frame: after the layout pass of a container tree (see flush_all_alerts) or at the end of the frame.
+/// Queued alerts are delivered in the order they were first queued, a merged duplicate keeps the position of the first one
+/// and is delivered as the latest one. Alerts queued by handlers during a flush are delivered in the same flush.
+///
+/// Dispatching and the deferred queue belong to the main thread. Other threads post alerts (see post_alert) into a lock-free
+/// queue, which is drained on the main thread at the end of the frame or at the next flush.
+///
+/// Building with HARMONIA_ALERT_STATS (scons alert_stats=yes) records dispatch counts, subscriber counts and handler latency
+/// histograms per alert type, see get_alert_stats. Without it none of the recording is compiled in.
 class AlertManager : public Object
 {
     GDCLASS(AlertManager, Object);
-private:
-
 public:
     AlertManager() = default;
-    ~AlertManager() = default;
-    
-    std::unordered_map<std::string, std::unordered_set<std::shared_ptr<std::function<void(Alert*)> > > > binds;
-    std::unordered_map<std::string, std::unordered_map<int64_t, std::shared_ptr<std::function<void(Alert*)> > > > godot_binds; // int64_t for Callable hash
+    ~AlertManager();
 
+    /// @brief A bound handler, either a C++ function or a Godot callable.
+    struct Handler {
+        std::shared_ptr<std::function<void(Alert*)>> function;
+        Callable callable;
+        /// @brief Cleared when the handler is unbound, dispatches still iterating an older snapshot skip it.
+        std::shared_ptr<std::atomic<bool>> active;
+#ifdef HARMONIA_ALERT_STATS
+        /// @brief Latency of this handler, shared by the snapshots holding it.
+        std::shared_ptr<AlertLatencyStats> stats;
+#endif
+    };
+
+    /// @brief Dispatches an alert, or queues it in deferred mode.
     void dispatch_alert(Alert* alert);
+    /// @brief Dispatches an alert right away, even in deferred mode.
+    void dispatch_alert_immediate(Alert* alert);
+
+    /// @brief Posts an alert from any thread, it's dispatched on the main thread (in FIFO order per posting thread).
+    /// @note The alert must not be touched by the posting thread afterwards, its type is interned when it's dispatched.
+    void post_alert(Alert* alert);
+    /// @brief Dispatches the posted alerts, called on the main thread.
+    void drain_posted_alerts();
+
+    void add_bind(int alert_type, std::shared_ptr<std::function<void(Alert*)>> function);
+    void remove_bind(int alert_type, std::shared_ptr<std::function<void(Alert*)>> function);
     void add_bind(std::string alert_type, std::shared_ptr<std::function<void(Alert*)>> function);
     void remove_bind(std::string alert_type, std::shared_ptr<std::function<void(Alert*)>> function);
 
     void godot_add_bind(String alert_type, Callable callable);
     void godot_remove_bind(String alert_type, Callable callable);
 
+    /// @brief Gets the number of handlers bound to an alert type.
+    int get_bind_count(String alert_type);
+
+    /// NOTE: Deferred mode
+
+    /// @brief Are alerts queued and merged until the next flush.
+    bool deferred_mode {false};
+    /// @brief Sets deferred mode, turning it off flushes the queued alerts.
+    void set_deferred_mode(bool value);
+    bool get_deferred_mode();
+
+    /// @brief Dispatches all queued alerts.
+    void flush_alerts();
+    /// @brief Gets the number of queued alerts.
+    int get_queued_alert_count();
+    /// @brief Flushes every manager with queued alerts, in the order they queued their first alert.
+    static void flush_all_alerts();
+
+    /// NOTE: Stats, only recorded when built with HARMONIA_ALERT_STATS.
+
+    /// @brief Is the extension built with alert stats.
+    static bool is_alert_stats_enabled();
+    /// @brief Gets stats of this manager by alert type name, empty when stats are disabled.
+    /// @note Each type has dispatches, subscribers, handler latency (calls, total_usec, max_usec, histogram) and
+    /// the latency of each handler (handlers). Histogram bucket i counts calls under 2^i microseconds, the last one the rest.
+    Dictionary get_alert_stats();
+    /// @brief Clears stats of this manager.
+    void reset_alert_stats();
+    /// @brief Removes the Performance monitors of alert stats, called when the extension is deinitialized.
+    static void remove_stats_monitors();
+
+private:
+    using HandlerList = std::vector<Handler>;
+    /// @brief Handler lists by interned alert type, lists are shared between snapshots until they are changed.
+    using HandlerTable = std::vector<std::shared_ptr<const HandlerList>>;
+
+    /// @brief Current snapshot, read with std::atomic_load and replaced with std::atomic_store.
+    std::shared_ptr<const HandlerTable> handlers {std::make_shared<const HandlerTable>()};
+    /// @brief Serializes binding and unbinding, dispatching never takes it.
+    std::mutex handlers_mutex;
+
+    void add_handler(int alert_type, Handler handler);
+    /// @brief Removes the first handler matching, publishes a new snapshot without it.
+    void remove_handler(int alert_type, const std::function<bool(const Handler&)>& matches);
+
+    /// @brief Alert posted by another thread, the queue is an intrusive lock-free stack.
+    struct PostedAlert {
+        Ref<Alert> alert;
+        PostedAlert* next {nullptr};
+    };
+    /// @brief Last posted alert, the drain reverses the stack to restore the posting order.
+    std::atomic<PostedAlert*> posted_alerts {nullptr};
+    std::atomic<bool> drain_scheduled {false};
+
+    /// @brief What queued alerts are merged by.
+    struct QueueKey {
+        uint64_t sender;
+        int type;
+        int merge_key;
+        bool operator==(const QueueKey& other) const;
+    };
+    struct QueueKeyHash {
+        size_t operator()(const QueueKey& key) const;
+    };
+
+#ifdef HARMONIA_ALERT_STATS
+    struct TypeStats {
+        uint64_t dispatches {0};
+        /// @brief Handlers bound at the last dispatch.
+        int subscribers {0};
+        /// @brief Latency of all handlers of the type.
+        AlertLatencyStats handlers;
+    };
+    /// @brief Stats by interned alert type, only touched by dispatches on the main thread.
+    std::vector<TypeStats> type_stats;
+    TypeStats& get_type_stats(int alert_type);
+    /// @brief Counts a dispatch of a type for its Performance monitors, registers them with the first one.
+    static void record_monitored_dispatch(int alert_type, uint64_t handler_nsec);
+    static double get_monitored_dispatches(int alert_type);
+    static double get_monitored_handler_usec(int alert_type);
+#endif
+
+    /// @brief Passes of a flush, alerts queued by handlers after the last one wait for the next flush.
+    static constexpr int MAX_FLUSH_PASSES = 16;
+
+    std::vector<Ref<Alert>> alert_queue;
+    /// @brief Alerts of the current flush pass, kept to reuse its capacity.
+    std::vector<Ref<Alert>> flushing_alerts;
+    /// @brief Position of every queued alert by its key.
+    std::unordered_map<QueueKey, size_t, QueueKeyHash> queued_alerts;
+    bool flush_scheduled {false};
+    bool flushing {false};
+
+    void queue_alert(Alert* alert);
+    /// @brief Managers with queued alerts, in the order they queued their first alert.
+    static std::vector<AlertManager*>& get_pending_managers();
+    static void remove_pending_manager(AlertManager* manager);
+
 protected:
     static void _bind_methods();
-};
\ No newline at end of file
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <cstddef>
+#include <vector>
+
+using namespace godot;
+
+/// @brief Recycles alerts of one type instead of allocating (and registering) a new object for every dispatch.
+///
+/// The pool holds a reference to every pooled alert, an alert is free once that is the only reference left. Alerts kept
+/// by handlers, scripts or a deferred queue stay referenced and aren't reused until they are released.
+/// @note Not thread safe, acquire alerts on the main thread.
+template <class T>
+class AlertPool
+{
+public:
+    explicit AlertPool(size_t capacity = 64) : capacity(capacity) {}
+    ~AlertPool() = default;
+
+    /// @brief Gets a free pooled alert, or a new one when all are in use. The caller sets all of its fields.
+    /// @note Alerts created past the capacity aren't pooled, they are freed once released.
+    Ref<T> acquire();
+
+    /// @brief Releases all pooled alerts, has to be called before the engine shuts down.
+    void clear();
+
+    /// @brief Number of pooled alerts.
+    size_t size() const;
+
+private:
+    std::vector<Ref<T>> alerts;
+    size_t capacity;
+    /// @brief Where the next search for a free alert starts, the most recently acquired ones are the likeliest to be in use.
+    size_t cursor {0};
+};
+
+template <class T>
+Ref<T> AlertPool<T>::acquire(){
+    for (size_t i = 0; i < alerts.size(); i++)
+    {
+        size_t index = (cursor + i) % alerts.size();
+        if(alerts[index]->get_reference_count() == 1){
+            cursor = (index + 1) % alerts.size();
+            return alerts[index];
+        }
+    }
+
+    Ref<T> alert = memnew(T);
+    if(alerts.size() < capacity){
+        alerts.push_back(alert);
+    }
+    return alert;
+}
+
+template <class T>
+void AlertPool<T>::clear(){
+    alerts.clear();
+    cursor = 0;
+}
+
+template <class T>
+size_t AlertPool<T>::size() const{
+    return alerts.size();
+}
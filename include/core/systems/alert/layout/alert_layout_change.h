@@ -1,5 +1,8 @@
+#pragma once
+
 #include <godot_cpp/core/class_db.hpp>
 #include "core/systems/alert/alert.h"
+#include "core/systems/alert/alert_pool.h"
 
 /// @brief Class which allows for binding for size, position, or margin layout changes
 class AlertLayoutChange : public Alert
@@ -17,13 +20,38 @@ public:
 
     AlertLayoutChange() = default;
     AlertLayoutChange(String name, LayoutChanged changed);
+    /// @brief Creates the alert with an interned type, see get_layout_change_type()
+    AlertLayoutChange(int type, LayoutChanged changed);
+
+    /// @brief Interned type of layout change alerts ("layout-change", ContainerBox::ALERT_LAYOUT_CHANGE)
+    static int get_layout_change_type();
+
+    /// @brief Gets a pooled layout change alert, set up as a new one with the given changes and no sender.
+    static Ref<AlertLayoutChange> acquire(LayoutChanged changed, int changed_mask);
+    /// @brief Releases the pooled alerts, called when the extension is deinitialized.
+    static void clear_pool();
     
-    /// @brief The specific layout that was changed.
+    /// @brief The specific layout that was changed, UNSPECIFIED when more than one was (see changed_mask).
     LayoutChanged layout_changed {LayoutChanged::UNSPECIFIED};
+    /// @brief Gets the specific layout that was changed.
+    LayoutChanged get_layout_changed() const;
+
+    /// @brief Bits (1 << LayoutChanged) of everything that was changed, alerts merged by a layout update carry more than one.
+    int changed_mask {0};
+    /// @brief Gets the bits of everything that was changed.
+    int get_changed_mask() const;
+    /// @brief Was a specific layout changed.
+    bool has_change(LayoutChanged changed) const;
+    /// @brief Gets the bit of a layout change.
+    static int get_change_bit(LayoutChanged changed);
+    /// @brief Alerts with different changes aren't merged by deferred alert managers.
+    int get_merge_key() const override;
     /// @brief Gets this alerts name 
     String get_alert_name() const;
 protected:
     static void _bind_methods();
+private:
+    static AlertPool<AlertLayoutChange>& get_pool();
 };
 
 inline String AlertLayoutChange::get_alert_name() const
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <godot_cpp/godot.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <cstdint>
+
+using namespace godot;
+
+/// @brief Layout work of a container, or the totals of a frame.
+/// @note Times are only of the container itself, its children are measured separately.
+struct LayoutProfile {
+    /// @brief Calls of ContainerBox::update_layout
+    uint64_t relayouts {0};
+    /// @brief Time spent in ContainerBox::update_layout, includes the steps below (ns)
+    uint64_t layout_nsec {0};
+    /// @brief Time spent in the LayoutSolver (ns)
+    uint64_t solve_nsec {0};
+    /// @brief Time spent in ContainerBox::update_container_overflows (ns)
+    uint64_t overflow_nsec {0};
+    /// @brief Time spent in ContainerBox::update_children_position (ns)
+    uint64_t position_nsec {0};
+    /// @brief set_position calls issued on this container, its children and scrollbars.
+    uint64_t set_position_calls {0};
+    /// @brief set_size calls issued on this container, its content box and scrollbars.
+    uint64_t set_size_calls {0};
+
+    void add(const LayoutProfile& other);
+    /// @brief Gets the profile with times in microseconds (layout_usec, solve_usec, ...), fractional so sub-microsecond steps aren't lost.
+    Dictionary to_dictionary() const;
+};
+
+/// @brief Runtime toggled profiling of the layout, see ContainerBox::set_layout_profiling
+///
+/// Every container keeps its own LayoutProfile, the profiler also sums them per frame for the Performance monitors
+/// ("Harmonia Layout/..."), which show the totals of the last frame. Disabled, the profiling costs a flag check per step.
+/// Times are accumulated in nanoseconds, most steps of a single container take less than a microsecond.
+/// @note Layout runs on the main thread, so does the profiler.
+class LayoutProfiler
+{
+public:
+    static bool is_enabled();
+    /// @brief Enables profiling, adds the Performance monitors the first time.
+    static void set_enabled(bool value);
+
+    /// @brief Measures the time of a scope into a field of a profile and of the frame totals.
+    class Scope
+    {
+    public:
+        Scope(LayoutProfile& profile, uint64_t LayoutProfile::* field);
+        ~Scope();
+    private:
+        LayoutProfile* profile {nullptr};
+        uint64_t LayoutProfile::* field {nullptr};
+        uint64_t start {0};
+    };
+
+    /// @brief Adds to a counter of a profile and of the frame totals, when enabled.
+    static void count(LayoutProfile& profile, uint64_t LayoutProfile::* field, uint64_t amount = 1);
+
+    /// @brief Gets the totals of the last finished frame.
+    static LayoutProfile get_last_frame_totals();
+
+    /// @brief Removes the Performance monitors, called when the extension is deinitialized.
+    static void remove_monitors();
+
+private:
+    static inline bool enabled {false};
+    static inline bool monitors_added {false};
+    /// @brief Frame the current totals are of.
+    static inline uint64_t frame {0};
+    static inline LayoutProfile frame_totals;
+    static inline LayoutProfile last_frame_totals;
+
+    /// @brief Gets the totals of the current frame, moves the previous ones to the last frame totals.
+    static LayoutProfile& get_frame_totals();
+    static void add_monitors();
+    static double get_monitor(int field);
+};
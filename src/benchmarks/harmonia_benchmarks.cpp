@@ -0,0 +1,127 @@
+#ifdef HARMONIA_BENCHMARKS
+
+#include "benchmarks/harmonia_benchmarks.h"
+#include "commons/container_unit_converter.h"
+#include "commons/string_helper.h"
+#include "core/harmonia.h"
+#include <godot_cpp/classes/os.hpp>
+#include <chrono>
+
+namespace {
+    /// @brief Realistic property values, with readable digits and spaces the parser has to skip.
+    const char* const LENGTH_VALUES[] = {"10px", "50%", "1'000.5vw", "4vh", " 12.5 px ", "0.5%", "-8px", "1fr"};
+    constexpr int LENGTH_VALUE_COUNT = sizeof(LENGTH_VALUES) / sizeof(LENGTH_VALUES[0]);
+
+    /// @brief 4 value padding and margin strings, [up right down left]
+    const char* const SIDE_VALUES[] = {"10px 5% 2vw 1vh", "4px 8px 4px 8px", "1'000px  0.5%  12vw  3vh"};
+    constexpr int SIDE_VALUE_COUNT = sizeof(SIDE_VALUES) / sizeof(SIDE_VALUES[0]);
+}
+
+template <class Function>
+Dictionary HarmoniaBenchmarks::measure(const String& name, int iterations, Function function){
+    for (int i = 0; i < iterations / 10 + 1; i++)
+    {
+        function(i);
+    }
+
+    // Godot tracks its static memory only in debug builds, release builds report 0.
+    OS* os = OS::get_singleton();
+    int64_t memory_before = (int64_t)os->get_static_memory_usage();
+    int64_t peak_before = (int64_t)os->get_static_memory_peak_usage();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        function(i);
+    }
+    double total_msec = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    int64_t memory_delta = (int64_t)os->get_static_memory_usage() - memory_before;
+    int64_t peak_delta = (int64_t)os->get_static_memory_peak_usage() - peak_before;
+
+    Dictionary result;
+    result["name"] = name;
+    result["iterations"] = iterations;
+    result["total_msec"] = total_msec;
+    result["nsec_per_op"] = total_msec * 1e6 / iterations;
+    result["ops_per_sec"] = total_msec > 0 ? iterations / (total_msec / 1000) : 0.0;
+    result["memory_tracked"] = os->is_debug_build();
+    result["static_memory_delta_per_op"] = (double)memory_delta / iterations;
+    result["static_memory_peak_delta"] = peak_delta;
+    result["checksum"] = checksum;
+    return result;
+}
+
+Array HarmoniaBenchmarks::run_commons(int iterations){
+    Array results;
+    if(iterations <= 0) return results;
+    checksum = 0;
+
+    // Strings are created up front, the benchmarks measure the helpers and not the conversion from C strings.
+    String lengths[LENGTH_VALUE_COUNT];
+    for (int i = 0; i < LENGTH_VALUE_COUNT; i++)
+    {
+        lengths[i] = LENGTH_VALUES[i];
+    }
+    String sides[SIDE_VALUE_COUNT];
+    for (int i = 0; i < SIDE_VALUE_COUNT; i++)
+    {
+        sides[i] = SIDE_VALUES[i];
+    }
+    const String space = " ";
+    const String empty = "";
+
+    results.push_back(measure("LengthPair::get_pair", iterations, [&](int i){
+        LengthPair pair = LengthPair::get_pair(lengths[i % LENGTH_VALUE_COUNT]);
+        checksum += pair.length + pair.unit_type;
+    }));
+
+    results.push_back(measure("get_string_number", iterations, [&](int i){
+        int stopped_at = 0;
+        checksum += get_string_number(lengths[i % LENGTH_VALUE_COUNT], true, true, &stopped_at).length() + stopped_at;
+    }));
+
+    results.push_back(measure("replace (spaces of 4 values)", iterations, [&](int i){
+        checksum += replace(sides[i % SIDE_VALUE_COUNT], space, empty).length();
+    }));
+
+    results.push_back(measure("split (4 values)", iterations, [&](int i){
+        checksum += split(sides[i % SIDE_VALUE_COUNT], space).size();
+    }));
+
+    // What the padding and margin setters do with a 4 value string.
+    results.push_back(measure("split + get_pair (4 values)", iterations, [&](int i){
+        List<String> values = split(sides[i % SIDE_VALUE_COUNT], space);
+        for (int value = 0; value < values.size(); value++)
+        {
+            checksum += LengthPair::get_pair(values[value]).length;
+        }
+    }));
+
+    const Vector2i window_size(1920, 1080);
+    LengthPair pairs[LENGTH_VALUE_COUNT];
+    for (int i = 0; i < LENGTH_VALUE_COUNT; i++)
+    {
+        pairs[i] = LengthPair::get_pair(lengths[i]);
+    }
+
+    results.push_back(measure("ContainerUnitConverter::get_width (to px)", iterations, [&](int i){
+        checksum += ContainerUnitConverter::get_width(pairs[i % LENGTH_VALUE_COUNT], 800, window_size);
+    }));
+
+    results.push_back(measure("ContainerUnitConverter::get_height (to vw)", iterations, [&](int i){
+        checksum += ContainerUnitConverter::get_height(pairs[i % LENGTH_VALUE_COUNT], 600, window_size, Harmonia::Unit::VIEWPORT_WIDTH);
+    }));
+
+    results.push_back(measure("LengthPair::get_pair_str", iterations, [&](int i){
+        checksum += LengthPair::get_pair_str(pairs[i % LENGTH_VALUE_COUNT]).length();
+    }));
+
+    return results;
+}
+
+void HarmoniaBenchmarks::_bind_methods(){
+    ClassDB::bind_method(D_METHOD("run_commons", "iterations"), &HarmoniaBenchmarks::run_commons, DEFVAL(200000));
+}
+
+#endif
@@ -1,142 +1,43 @@
 #include "commons/container_unit_converter.h"
+#include "core/layout/unit_batch.h"
 
-double ContainerUnitConverter::get_width(LengthPair pair, double parent_width, Vector2i window_size, int unit_type)
-{
-    if(unit_type == Harmonia::Unit::PIXEL){
-        return get_width_px(pair, parent_width, window_size);
-    }else if(unit_type == Harmonia::Unit::PERCENTAGE){
-        return get_width_percentage(pair, parent_width, window_size);
-    }else if(unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return get_width_vw(pair, parent_width, window_size);
-    }else if(unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return get_width_vh(pair, parent_width, window_size);
-    }else{
-        return NULL;
-    }
-}
-
-double ContainerUnitConverter::get_width_px(LengthPair pair, double parent_width, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return pair.length;
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return percentage_to_px(pair.length, parent_width);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return vw_to_px(pair.length, window_size.x);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return vh_to_px(pair.length, window_size.y);
-    }else{
-        return NULL;
-    }
-}
-
-double ContainerUnitConverter::get_width_vw(LengthPair pair, double parent_width, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return px_to_vw(pair.length, window_size.x);
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return percentage_to_vw(pair.length, window_size.x, parent_width);
-    } else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return pair.length;
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return vh_to_vw(pair.length, window_size.x, window_size.y);
-    }else{
-        return NULL;
-    }
-}
+static_assert(UnitConversion::PIXEL == static_cast<int>(Harmonia::Unit::PIXEL)
+    && UnitConversion::PERCENTAGE == static_cast<int>(Harmonia::Unit::PERCENTAGE)
+    && UnitConversion::VIEWPORT_WIDTH == static_cast<int>(Harmonia::Unit::VIEWPORT_WIDTH)
+    && UnitConversion::VIEWPORT_HEIGHT == static_cast<int>(Harmonia::Unit::VIEWPORT_HEIGHT),
+    "UnitConversion units have to match Harmonia units");
+static_assert(UnitConversion::UNIT_COUNT == static_cast<int>(Harmonia::Unit::FRACTION),
+    "Fractions are not convertible, they have to stay outside of the UnitConversion tables");
 
-double ContainerUnitConverter::get_width_vh(LengthPair pair, double parent_width, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return px_to_vh(pair.length, window_size.y);
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return percentage_to_vh(pair.length, window_size.y, parent_width);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return vw_to_vh(pair.length, window_size.x, window_size.y);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return pair.length;
-    }else{
-        return NULL;
-    }
+UnitContext ContainerUnitConverter::get_context(double parent_width, double parent_height, Vector2i window_size){
+    UnitContext context;
+    context.parent_width = parent_width;
+    context.parent_height = parent_height;
+    context.viewport_width = window_size.x;
+    context.viewport_height = window_size.y;
+    return context;
 }
 
-double ContainerUnitConverter::get_width_percentage(LengthPair pair, double parent_width, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return px_to_percentage(pair.length, parent_width);
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return pair.length;
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return vw_to_percentage(pair.length, window_size.x, parent_width);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return vh_to_percentage(pair.length, window_size.y, parent_width);
-    }else{
-        return NULL;
-    }
+double ContainerUnitConverter::get_width(LengthPair pair, double parent_width, Vector2i window_size, int unit_type)
+{
+    return UnitConversion::convert(pair.unit_type, unit_type, UnitAxis::WIDTH, pair.length, get_context(parent_width, 0, window_size));
 }
 
-double ContainerUnitConverter::get_height(LengthPair pair, double parent_height, Vector2i window_size, int unit_type){
-    if(unit_type == Harmonia::Unit::PIXEL){
-        return get_height_px(pair, parent_height, window_size);
-    }else if(unit_type == Harmonia::Unit::PERCENTAGE){
-        return get_height_percentage(pair, parent_height, window_size);
-    }else if(unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return get_height_vw(pair, parent_height, window_size);
-    }else if(unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return get_height_vh(pair, parent_height, window_size);
-    }else{
-        return NULL;
-    }
+double ContainerUnitConverter::get_height(LengthPair pair, double parent_height, Vector2i window_size, int unit_type)
+{
+    return UnitConversion::convert(pair.unit_type, unit_type, UnitAxis::HEIGHT, pair.length, get_context(0, parent_height, window_size));
 }
 
-double ContainerUnitConverter::get_height_px(LengthPair pair, double parent_height, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return pair.length;
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return percentage_to_px(pair.length, parent_height);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return vw_to_px(pair.length, window_size.x);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return vh_to_px(pair.length, window_size.y);
-    }else{
-        return NULL;
-    }
+void ContainerUnitConverter::get_px_batch(const int32_t* units, const double* lengths, const double* parent_sizes, Vector2i window_size, double* results, size_t count){
+    UnitBatch::to_pixels(units, lengths, parent_sizes, window_size.x, window_size.y, results, count);
 }
 
-double ContainerUnitConverter::get_height_vw(LengthPair pair, double parent_height, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return px_to_vw(pair.length, window_size.x);
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return percentage_to_vw(pair.length, window_size.x, parent_height);
-    } else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return pair.length;
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return vh_to_vw(pair.length, window_size.x, window_size.y);
-    }else{
-        return NULL;
-    }
-}
+PackedFloat64Array ContainerUnitConverter::get_px_batch(const PackedInt32Array& units, const PackedFloat64Array& lengths, const PackedFloat64Array& parent_sizes, Vector2i window_size){
+    PackedFloat64Array results;
+    int64_t count = units.size();
+    if(lengths.size() != count || parent_sizes.size() != count) return results;
 
-double ContainerUnitConverter::get_height_vh(LengthPair pair, double parent_height, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return px_to_vh(pair.length, window_size.y);
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return percentage_to_vh(pair.length, window_size.y, parent_height);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return vw_to_vh(pair.length, window_size.x, window_size.y);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return pair.length;
-    }else{
-        return NULL;
-    }
+    results.resize(count);
+    get_px_batch(units.ptr(), lengths.ptr(), parent_sizes.ptr(), window_size, results.ptrw(), count);
+    return results;
 }
-
-double ContainerUnitConverter::get_height_percentage(LengthPair pair, double parent_height, Vector2i window_size){
-    if(pair.unit_type == Harmonia::Unit::PIXEL){
-        return px_to_percentage(pair.length, parent_height);
-    }else if(pair.unit_type == Harmonia::Unit::PERCENTAGE){
-        return pair.length;
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_WIDTH){
-        return vw_to_percentage(pair.length, window_size.x, parent_height);
-    }else if(pair.unit_type == Harmonia::Unit::VIEWPORT_HEIGHT){
-        return vh_to_percentage(pair.length, window_size.y, parent_height);
-    }else{
-        return NULL;
-    }
-}
\ No newline at end of file
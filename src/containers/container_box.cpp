@@ -7,17 +7,30 @@
 #include <godot_cpp/classes/input_event_mouse_button.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include "core/systems/alert/layout/alert_layout_change.h"
+#include "core/layout/layout_solver.h"
 #include "commons/string_helper.h"
+#include <algorithm>
+
+static_assert(SpatialIndex::REGION_HORIZONTAL_SCROLLBAR == static_cast<int>(Harmonia::PickRegion::PICK_HORIZONTAL_SCROLLBAR),
+    "SpatialIndex::Region has to match Harmonia::PickRegion");
 
 void ContainerBox::on_window_size_changed(){
-    window_size = get_tree()->get_root()->get_visible_rect().size;
+    set_window_size(get_tree()->get_root()->get_visible_rect().size);
+}
+
+void ContainerBox::set_window_size(const Size2& new_window_size){
+    if(window_size == new_window_size) return;
+    window_size = new_window_size;
+    // Viewport units and percentages of the root depend on it, children resolve against the new sizes.
+    invalidate_geometry(true);
+    mark_layout_dirty();
 }
 
 void ContainerBox::_ready(){
     if (Engine::get_singleton()->is_editor_hint()) {
-        window_size = Size2(
+        set_window_size(Size2(
             ProjectSettings::get_singleton()->get_setting("display/window/size/viewport_width"), 
-            ProjectSettings::get_singleton()->get_setting("display/window/size/viewport_height"));
+            ProjectSettings::get_singleton()->get_setting("display/window/size/viewport_height")));
 
         ContentBox* found_content_box = find_content_box();
         if(found_content_box == nullptr){
@@ -29,7 +42,7 @@ void ContainerBox::_ready(){
         if(!get_tree()->get_root()->is_connected("size_changed", Callable(this, "on_window_size_changed"))){
             get_tree()->get_root()->connect("size_changed", Callable(this, "on_window_size_changed"));
         }
-        window_size = get_tree()->get_root()->get_visible_rect().size;
+        set_window_size(get_tree()->get_root()->get_visible_rect().size);
     }
 
     if(alert_manager == nullptr){
@@ -37,7 +50,6 @@ void ContainerBox::_ready(){
         alert_manager = memnew(AlertManager);
     }
 
-    set_process(true);
     set_string_scroll_y_step("10px");
     set_string_scroll_x_step("10px");
     if(content_box){
@@ -65,19 +77,313 @@ void ContainerBox::_ready(){
             content_box->scrollbar_x = hscroll;
         }
     }
+
+    if(content_box && !content_box->is_connected("child_order_changed", Callable(this, "on_children_changed"))){
+        content_box->connect("child_order_changed", Callable(this, "on_children_changed"));
+    }
+
+    mark_layout_dirty();
+}
+
+void ContainerBox::mark_layout_dirty(){
+    layout_dirty = true;
+    if(parent){
+        parent->layout_dirty = true;
+    }
+
+    ContainerBox* root = this;
+    while(root->parent != nullptr){
+        root = root->parent;
+        root->child_layout_dirty = true;
+    }
+
+    if(!root->layout_scheduled){
+        root->layout_scheduled = true;
+        root->call_deferred("flush_layout");
+    }
+}
+
+void ContainerBox::flush_layout(){
+    layout_scheduled = false;
+    if(parent != nullptr || !is_inside_tree()){
+        return; // Got parented after scheduling, the new root container does the relayout.
+    }
+    update_layout_pass();
+}
+
+void ContainerBox::update_layout_pass(bool force){
+    bool relayout = force || layout_dirty;
+    bool walk_children = relayout || child_layout_dirty;
+    layout_dirty = false;
+    child_layout_dirty = false;
+
+    if(!walk_children) return;
+    if(parent == nullptr){
+        spatial_index_dirty = true;
+    }
+
+    // Children are retrieved once and shared by sizing, positioning and the walk down.
+    TypedArray<Node> children = get_layout_children();
+    if(relayout){
+        update_layout(children);
+    }
+
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            if(container->parent != this){
+                // Fixes containers parented before their content box was added to this container.
+                container->parent = this;
+                container->invalidate_geometry(true);
+            }
+            container->update_layout_pass(relayout);
+        }
+    }
+
+    if(parent == nullptr){
+        update_background_batches();
+    }
+
+    // Process modes changed by culling would be saved into the edited scene.
+    if(parent == nullptr && !Engine::get_singleton()->is_editor_hint()){
+        update_culling(Rect2(), false);
+    }
+
+    // Deferred alerts are delivered once the layout is final.
+    if(parent == nullptr){
+        AlertManager::flush_all_alerts();
+    }
+}
+
+TypedArray<Node> ContainerBox::get_layout_children(){
+    if(content_box){
+        return content_box->get_children();
+    }
+    return get_children();
+}
+
+ContainerBox* ContainerBox::get_root_container(){
+    ContainerBox* root = this;
+    while(root->parent != nullptr){
+        root = root->parent;
+    }
+    return root;
+}
+
+void ContainerBox::on_children_changed(){
+    // Removed children must not stay culled, the layout pass culls the remaining ones again.
+    restore_culled_children();
+    mark_layout_dirty();
+}
+
+void ContainerBox::rebuild_spatial_index(){
+    spatial_index.clear();
+    spatial_containers.clear();
+    if(is_visible()){
+        add_spatial_entries(spatial_index, spatial_containers, 0, Vector2(0, 0), 0); // Root scope is the local space of the root container.
+    }
+    spatial_index.build();
+    spatial_index_dirty = false;
+}
+
+void ContainerBox::add_spatial_entries(SpatialIndex& index, std::vector<ObjectID>& containers, int scope, Vector2 origin, int depth){
+    Vector2 size = get_size();
+    SpatialIndex::Entry entry;
+    entry.id = containers.size();
+    entry.depth = depth;
+    entry.rect = {origin.x, origin.y, size.x, size.y};
+    entry.scrollable = content_box && overflow_behaviour == Harmonia::SCROLL && (is_overflowed_x || is_overflowed_y);
+    if(entry.scrollable && vertical_scroll && vertical_scroll->is_visible()){
+        Vector2 scroll_position = origin + vertical_scroll->get_position();
+        Vector2 scroll_size = vertical_scroll->get_size();
+        entry.vertical_scrollbar = {scroll_position.x, scroll_position.y, scroll_size.x, scroll_size.y};
+    }
+    if(entry.scrollable && horizontal_scroll && horizontal_scroll->is_visible()){
+        Vector2 scroll_position = origin + horizontal_scroll->get_position();
+        Vector2 scroll_size = horizontal_scroll->get_size();
+        entry.horizontal_scrollbar = {scroll_position.x, scroll_position.y, scroll_size.x, scroll_size.y};
+        entry.horizontal_scrollbar_band = size.y * content_box->scroll_x_checking_size;
+    }
+    containers.push_back(get_instance_id());
+    spatial_origin = origin;
+    spatial_scope = -1;
+
+    // Content box children get their own scope, so scrolling doesn't invalidate their rects.
+    int children_scope = scope;
+    Vector2 children_origin = origin;
+    if(content_box){
+        spatial_scope = index.add_scope();
+        entry.content_scope = spatial_scope;
+        Vector2 content_origin = origin + content_box->get_position();
+        index.set_scope_origin(spatial_scope, content_origin.x, content_origin.y);
+        children_scope = spatial_scope;
+        children_origin = Vector2(0, 0);
+    }
+    index.add_entry(scope, entry);
+
+    TypedArray<Node> children = get_layout_children();
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            if(!container->is_visible()) continue;
+            container->add_spatial_entries(index, containers, children_scope, children_origin + container->get_position(), depth + 1);
+        }
+    }
+}
+
+void ContainerBox::update_spatial_scope(){
+    ContainerBox* root = get_root_container();
+    if(root->spatial_index_dirty || spatial_scope < 0 || content_box == nullptr) return;
+    Vector2 content_origin = spatial_origin + content_box->get_position();
+    root->spatial_index.set_scope_origin(spatial_scope, content_origin.x, content_origin.y);
+}
+
+SpatialIndex::Hit ContainerBox::pick_hit(Vector2 global_point){
+    ContainerBox* root = get_root_container();
+    if(root->spatial_index_dirty){
+        root->rebuild_spatial_index();
+    }
+    Vector2 point = root->get_global_transform().affine_inverse().xform(global_point);
+    return root->spatial_index.query(point.x, point.y);
+}
+
+ContainerBox* ContainerBox::get_spatial_container(int id){
+    ContainerBox* root = get_root_container();
+    if(id < 0 || id >= (int)root->spatial_containers.size()) return nullptr;
+    return Object::cast_to<ContainerBox>(ObjectDB::get_instance(root->spatial_containers[id]));
+}
+
+Dictionary ContainerBox::pick(Vector2 global_point){
+    SpatialIndex::Hit hit = pick_hit(global_point);
+    Dictionary result;
+    result["container"] = get_spatial_container(hit.id);
+    result["scrollable"] = get_spatial_container(hit.scrollable_id);
+    result["region"] = static_cast<Harmonia::PickRegion>(hit.region);
+    return result;
+}
+
+ContainerBox* ContainerBox::get_scrollable_at(Vector2 global_point){
+    return get_spatial_container(pick_hit(global_point).scrollable_id);
+}
+
+void ContainerBox::set_culling(bool value){
+    culling = value;
+    if(culling){
+        if(!Engine::get_singleton()->is_editor_hint()) update_culling(culling_clip, culling_has_clip);
+    }else{
+        restore_culled_children();
+    }
+}
+
+bool ContainerBox::get_culling(){
+    return culling;
+}
+
+void ContainerBox::update_culling(Rect2 clip, bool has_clip){
+    culling_clip = clip;
+    culling_has_clip = has_clip;
+    if(content_box && content_box->virtualized) return; // Items outside of the view are released by the content box.
+
+    // Clip in the space of the children, the content box is moved by the scroll and clips its unscrolled area.
+    if(content_box){
+        clip.position -= content_box->get_position();
+        if(content_box->clipping){
+            Rect2 content_clip = Rect2(Vector2(-content_box->scroll_left_px, -content_box->scroll_top_px), content_box->get_size());
+            clip = has_clip ? clip.intersection(content_clip) : content_clip;
+            has_clip = true;
+        }
+    }
+
+    TypedArray<Node> children = get_layout_children();
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        auto* control = Object::cast_to<Control>(children[i]);
+        if(control == nullptr) continue;
+        if(!control->is_visible()){
+            set_child_culled(control, false); // Hidden children take no space and stay unculled until shown.
+            continue;
+        }
+
+        Rect2 rect = Rect2(control->get_position(), control->get_size());
+        bool culled = culling && has_clip && !clip.intersects(rect);
+        set_child_culled(control, culled);
+        if(culled) continue;
+
+        if(auto* container = Object::cast_to<ContainerBox>(control)){
+            container->update_culling(Rect2(clip.position - rect.position, clip.size), has_clip);
+        }
+    }
+}
+
+void ContainerBox::set_child_culled(Control* child, bool culled){
+    uint64_t id = child->get_instance_id();
+    auto found = culled_children.find(id);
+    if(culled == (found != culled_children.end())) return;
+
+    // Visibility goes directly to the rendering server, the node stays visible so layout and the editor are not affected.
+    if(culled){
+        culled_children[id] = child->get_process_mode();
+        RenderingServer::get_singleton()->canvas_item_set_visible(child->get_canvas_item(), false);
+        child->set_process_mode(Node::PROCESS_MODE_DISABLED);
+        // Showing a node makes its canvas item visible again behind the back of culling.
+        child->connect("visibility_changed", callable_mp(this, &ContainerBox::on_culled_child_visibility_changed).bind(id));
+    }else{
+        Node::ProcessMode process_mode = found->second;
+        culled_children.erase(found);
+        uncull_child(child, process_mode);
+    }
+}
+
+void ContainerBox::uncull_child(Control* child, Node::ProcessMode process_mode){
+    RenderingServer::get_singleton()->canvas_item_set_visible(child->get_canvas_item(), child->is_visible());
+    if(child->get_process_mode() == Node::PROCESS_MODE_DISABLED){
+        child->set_process_mode(process_mode);
+    }
+
+    Callable on_visibility_changed = callable_mp(this, &ContainerBox::on_culled_child_visibility_changed).bind(child->get_instance_id());
+    if(child->is_connected("visibility_changed", on_visibility_changed)){
+        child->disconnect("visibility_changed", on_visibility_changed);
+    }
+}
+
+void ContainerBox::on_culled_child_visibility_changed(uint64_t id){
+    auto found = culled_children.find(id);
+    if(found == culled_children.end()) return;
+
+    Node::ProcessMode process_mode = found->second;
+    culled_children.erase(found);
+    if(auto* child = Object::cast_to<Control>(ObjectDB::get_instance(ObjectID(id)))){
+        uncull_child(child, process_mode);
+    }
+
+    // A shown child that is still outside of the clip is culled again before it's drawn.
+    if(!Engine::get_singleton()->is_editor_hint()){
+        update_culling(culling_clip, culling_has_clip);
+    }
+}
+
+void ContainerBox::restore_culled_children(){
+    std::unordered_map<uint64_t, Node::ProcessMode> restored;
+    restored.swap(culled_children);
+    for (const auto& [id, process_mode] : restored)
+    {
+        if(auto* child = Object::cast_to<Control>(ObjectDB::get_instance(ObjectID(id)))){
+            uncull_child(child, process_mode);
+        }
+    }
 }
 
-void ContainerBox::_process(double time) {
-    update_time += time;
-    if(update_time >= update_interval){
-        update_presentation();
-        update_time -= update_interval;
+void ContainerBox::on_content_scrolled(){
+    update_spatial_scope();
+    if(!Engine::get_singleton()->is_editor_hint()){
+        update_culling(culling_clip, culling_has_clip);
     }
 }
 
 void ContainerBox::set_visibility(Harmonia::Visibility new_visibility){
     visibility = new_visibility;
     apply_visibility();
+    mark_layout_dirty();
 }
 
 Harmonia::Visibility ContainerBox::get_visibility(){
@@ -111,14 +417,7 @@ void ContainerBox::create_content_box(){
 }
 
 double ContainerBox::calculate_overflow(double container, double check_size, double current_overflow){
-    if(check_size > container){
-        double overflow = check_size - container;
-        if(overflow > current_overflow){
-            return overflow;
-        }
-    }
-
-    return current_overflow;
+    return LayoutSolver::calculate_overflow(container, check_size, current_overflow);
 }
 
 void ContainerBox::check_overflows(Vector2 overflow){
@@ -139,92 +438,13 @@ void ContainerBox::check_overflows(Vector2 overflow){
     } 
 }
 
-void ContainerBox::update_container_overflows(TypedArray<Node> children){
-    Vector2 overflow = Vector2(0, 0);
-    Vector2 negative_overflow = Vector2(0, 0);
-    Vector2 sum_child_sizes = Vector2(0, get_padding_up());
-
-    for (size_t i = 0; i < children.size(); i++)
-    {
-        auto current_child = children[i];
-        if(auto* container = Object::cast_to<ContainerBox>(current_child)){
-            if(container->get_visibility() == Harmonia::OBJECT_HIDDEN) continue;
-
-            double m_up = container->get_margin_up();
-            double m_down = container->get_margin_down();
-            double m_left = container->get_margin_left();
-            double m_right = container->get_margin_right();
-            double p_up = container->get_padding_up();
-            double p_down = container->get_padding_down();
-            double p_left = container->get_padding_left();
-            double p_right = container->get_padding_right();
-            double sum_x = container->get_width() + m_left + m_right + p_left + p_right;
-            double sum_y = container->get_height() + m_up + m_down + p_up + p_down;
-            double overflow_check_x {0};
-            double overflow_check_y {0};
-            double negative_overflow_check_x {0};
-            double negative_overflow_check_y {0};
-
-            if(m_left < 0){
-                negative_overflow_check_x = m_left;
-            }
-            if(m_up < 0){
-                negative_overflow_check_y = m_up;
-            }
-
-            if(container->position_type == Harmonia::Position::STATIC){
-                overflow_check_x += sum_x;
-                sum_child_sizes.y += sum_y;
-                if(debug_outputs) UtilityFunctions::print("margin left ", m_left);
-            }else if(container->position_type == Harmonia::Position::ABSOLUTE){
-                double pos_x = container->get_pos_x();
-                double pos_y = container->get_pos_y();
-                overflow_check_x += pos_x + sum_x;
-                overflow_check_y += pos_y + sum_y;
-                if(m_left + pos_x < 0){
-                    negative_overflow_check_x = (m_left + pos_x);
-                }
-                if(m_up + pos_y < 0){
-                    negative_overflow_check_y = (m_up + pos_y);
-                }
-            }else if(container-> position_type == Harmonia::Position::RELATIVE){
-                double pos_x = container->get_pos_x();
-                double pos_y = container->get_pos_y();
-                overflow_check_x += pos_x + sum_x;
-                overflow_check_y += pos_y + sum_y;
-                sum_child_sizes.y += sum_y;
-                if(m_left + pos_x < 0){
-                    negative_overflow_check_x = (m_left + pos_x);
-                }
-                if(m_up + pos_y < 0){
-                    negative_overflow_check_y = (m_up + pos_y);
-                }
-            }
-            overflow.x = calculate_overflow(get_width(), overflow_check_x, overflow.x);
-            overflow.y = calculate_overflow(get_height(), overflow_check_y, overflow.y);
-
-            if(negative_overflow_check_x < negative_overflow.x){ 
-                negative_overflow.x = negative_overflow_check_x;
-                if(debug_outputs) UtilityFunctions::print("Overflow x ", negative_overflow.x);
-            };
-            if(negative_overflow_check_y < negative_overflow.y) negative_overflow.y = negative_overflow_check_y;
-        }
-        else if(auto* control = Object::cast_to<Control>(current_child)){
-            // UNIMPLEMENTED
-        }
-    }
-    
-    overflow.x = calculate_overflow(get_width(), sum_child_sizes.x, overflow.x);
-    overflow.y = calculate_overflow(get_height(), sum_child_sizes.y, overflow.y);
-    negative_overflow_x = negative_overflow.x;
-    overflow.x += abs(negative_overflow.x);
-    negative_overflow_y = negative_overflow.y;
-    overflow.y += abs(negative_overflow.y);
-    check_overflows(negative_overflow);
-    check_overflows(overflow);
+void ContainerBox::update_container_overflows(){
+    negative_overflow_x = layout_node.negative_overflow_x;
+    negative_overflow_y = layout_node.negative_overflow_y;
+    check_overflows(Vector2(layout_node.overflow_x, layout_node.overflow_y));
 
-    if(debug_outputs) UtilityFunctions::print("Overflow: ", overflow);
-    if(debug_outputs) UtilityFunctions::print("Negative overflow: ", negative_overflow, "\n");
+    if(debug_outputs) UtilityFunctions::print("Overflow: ", Vector2(layout_node.overflow_x, layout_node.overflow_y));
+    if(debug_outputs) UtilityFunctions::print("Negative overflow: ", Vector2(negative_overflow_x, negative_overflow_y), "\n");
 }
 
 void ContainerBox::set_overflow_x_size(double value, Harmonia::Unit unit_type){
@@ -251,6 +471,8 @@ void ContainerBox::position_scrolls(){
         vscroll_size = vertical_scroll->get_size();
         vertical_scroll->set_size(Vector2(vscroll_size.x, get_height()));
         vertical_scroll->set_position(Vector2(get_width()-vscroll_size.x, 0));
+        LayoutProfiler::count(layout_profile, &LayoutProfile::set_size_calls);
+        LayoutProfiler::count(layout_profile, &LayoutProfile::set_position_calls);
     } 
 
     if(horizontal_scroll){
@@ -261,6 +483,8 @@ void ContainerBox::position_scrolls(){
             horizontal_scroll->set_size(Vector2(get_width(), hscroll_size.y));
         }
         horizontal_scroll->set_position(Vector2(0, get_height()-hscroll_size.y));
+        LayoutProfiler::count(layout_profile, &LayoutProfile::set_size_calls);
+        LayoutProfiler::count(layout_profile, &LayoutProfile::set_position_calls);
     }
 }
 
@@ -310,7 +534,7 @@ NodePath ContainerBox::get_horizontal_scroll(){
 
 void ContainerBox::set_string_scroll_y_step(String value){
     string_scroll_y_step = value;
-    LengthPair new_scroll_y_step = LengthPair::get_pair(value);
+    LengthPair new_scroll_y_step = parse_length(value, "scroll y step");
     set_scroll_y_step(new_scroll_y_step.length, new_scroll_y_step.unit_type);
 }
 
@@ -327,12 +551,15 @@ void ContainerBox::set_scroll_y_step(double value, Harmonia::Unit unit_type){
 }
 
 double ContainerBox::get_scroll_y_step(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL){
+        return UnitConversion::convert_to<UnitConversion::PIXEL, UnitAxis::HEIGHT>(scroll_y_step.unit_type, scroll_y_step.length, get_unit_context());
+    }
     return get_height_length_pair_unit(scroll_y_step, unit_type);
 }
 
 void ContainerBox::set_string_scroll_x_step(String value){
     string_scroll_x_step = value;
-    LengthPair new_scroll_x_step = LengthPair::get_pair(value);
+    LengthPair new_scroll_x_step = parse_length(value, "scroll x step");
     set_scroll_x_step(new_scroll_x_step.length, new_scroll_x_step.unit_type);
     if(content_box){
         content_box->scroll_step_left_px = get_scroll_x_step();
@@ -349,14 +576,165 @@ void ContainerBox::set_scroll_x_step(double value, Harmonia::Unit unit_type){
 }
 
 double ContainerBox::get_scroll_x_step(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL){
+        return UnitConversion::convert_to<UnitConversion::PIXEL, UnitAxis::WIDTH>(scroll_x_step.unit_type, scroll_x_step.length, get_unit_context());
+    }
     return get_width_length_pair_unit(scroll_x_step, unit_type);
 }
 
 void ContainerBox::draw_ui(){
+    if(is_background_batched()) return;
     Rect2 rect = Rect2(Vector2(0, 0), Size2(ceil(calculate_total_width()), ceil(calculate_total_height())));
     draw_rect(rect, background_color);
 }
 
+void ContainerBox::set_batch_backgrounds(bool value){
+    if(batch_backgrounds == value) return;
+    batch_backgrounds = value;
+    if(!batch_backgrounds){
+        free_background_batches();
+    }
+    redraw_backgrounds();
+    mark_layout_dirty(); // Batches are collected at the end of the layout pass.
+}
+
+bool ContainerBox::get_batch_backgrounds(){
+    return batch_backgrounds;
+}
+
+bool ContainerBox::is_background_batched(){
+    return get_root_container()->batch_backgrounds;
+}
+
+void ContainerBox::queue_background_redraw(){
+    ContainerBox* root = get_root_container();
+    if(!root->batch_backgrounds){
+        queue_redraw();
+        return;
+    }
+    // A scheduled layout pass updates the batches anyway.
+    if(!root->layout_scheduled && !root->backgrounds_scheduled){
+        root->backgrounds_scheduled = true;
+        root->call_deferred("flush_backgrounds");
+    }
+}
+
+void ContainerBox::flush_backgrounds(){
+    backgrounds_scheduled = false;
+    if(parent == nullptr){
+        update_background_batches();
+    }
+}
+
+void ContainerBox::update_background_batches(){
+    if(!batch_backgrounds || !is_inside_tree()) return;
+
+    size_t used_batches = 0;
+    size_t root_batch = acquire_background_batch(get_canvas_item(), used_batches);
+    if(is_visible()){
+        add_batched_backgrounds(this, root_batch, Vector2(0, 0), used_batches);
+    }
+
+    RenderingServer* rendering_server = RenderingServer::get_singleton();
+    for (size_t i = 0; i < used_batches; i++)
+    {
+        BackgroundBatch& batch = background_batches[i];
+        if(batch.cursor < batch.rects.size()){
+            batch.rects.resize(batch.cursor);
+            batch.colors.resize(batch.cursor);
+            batch.changed = true;
+        }
+        if(!batch.changed) continue;
+
+        rendering_server->canvas_item_clear(batch.canvas_item);
+        for (size_t j = 0; j < batch.rects.size(); j++)
+        {
+            rendering_server->canvas_item_add_rect(batch.canvas_item, batch.rects[j], batch.colors[j]);
+        }
+    }
+
+    // Areas that no longer exist.
+    for (size_t i = used_batches; i < background_batches.size(); i++)
+    {
+        rendering_server->free_rid(background_batches[i].canvas_item);
+    }
+    background_batches.resize(used_batches);
+}
+
+void ContainerBox::add_batched_backgrounds(ContainerBox* root, size_t batch, Vector2 origin, size_t& used_batches){
+    if(background_color.a > 0){
+        Rect2 rect = Rect2(origin, Size2(ceil(calculate_total_width()), ceil(calculate_total_height())));
+        BackgroundBatch& target = root->background_batches[batch];
+        // Compared in place, unchanged batches aren't resubmitted and don't allocate.
+        if(target.cursor < target.rects.size() && target.rects[target.cursor] == rect && target.colors[target.cursor] == background_color){
+            target.cursor++;
+        }else{
+            target.rects.resize(target.cursor);
+            target.colors.resize(target.cursor);
+            target.rects.push_back(rect);
+            target.colors.push_back(background_color);
+            target.cursor++;
+            target.changed = true;
+        }
+    }
+
+    size_t children_batch = batch;
+    Vector2 children_origin = origin;
+    if(content_box){
+        children_batch = root->acquire_background_batch(content_box->get_canvas_item(), used_batches);
+        children_origin = Vector2(0, 0);
+    }
+
+    TypedArray<Node> children = get_layout_children();
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            if(!container->is_visible()) continue;
+            container->add_batched_backgrounds(root, children_batch, children_origin + container->get_position(), used_batches);
+        }
+    }
+}
+
+size_t ContainerBox::acquire_background_batch(RID parent_item, size_t& used_batches){
+    RenderingServer* rendering_server = RenderingServer::get_singleton();
+    size_t index = used_batches++;
+    if(index == background_batches.size()){
+        background_batches.emplace_back();
+        background_batches[index].canvas_item = rendering_server->canvas_item_create();
+    }
+
+    BackgroundBatch& batch = background_batches[index];
+    batch.cursor = 0;
+    batch.changed = false;
+    if(batch.parent_item != parent_item){
+        batch.parent_item = parent_item;
+        rendering_server->canvas_item_set_parent(batch.canvas_item, parent_item);
+        rendering_server->canvas_item_set_draw_index(batch.canvas_item, -1); // Below the children of the area.
+        batch.changed = true;
+    }
+    return index;
+}
+
+void ContainerBox::free_background_batches(){
+    RenderingServer* rendering_server = RenderingServer::get_singleton();
+    for (BackgroundBatch& batch : background_batches)
+    {
+        rendering_server->free_rid(batch.canvas_item);
+    }
+    background_batches.clear();
+}
+
+void ContainerBox::redraw_backgrounds(){
+    queue_redraw();
+    TypedArray<Node> children = get_layout_children();
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            container->redraw_backgrounds();
+        }
+    }
+}
+
 double ContainerBox::get_width_length_pair_unit(LengthPair pair, Harmonia::Unit unit_type){
     if(unit_type == Harmonia::Unit::NOT_SET) return 0;
 
@@ -377,6 +755,246 @@ double ContainerBox::get_height_length_pair_unit(LengthPair pair, Harmonia::Unit
     return ContainerUnitConverter::get_height(pair, parent->get_height(), window_size, unit_type);
 }
 
+UnitContext ContainerBox::get_unit_context(){
+    if(parent == nullptr){
+        return ContainerUnitConverter::get_context(window_size.x, window_size.y, window_size);
+    }
+    return ContainerUnitConverter::get_context(parent->get_width(), parent->get_height(), window_size);
+}
+
+LayoutNode::Length ContainerBox::to_layout_length(const LengthPair& pair){
+    LayoutNode::Length length;
+    length.unit_type = static_cast<LayoutNode::Unit>(pair.unit_type);
+    length.length = pair.length;
+    return length;
+}
+
+void ContainerBox::to_layout_tracks(const std::vector<LengthPair>& tracks, std::vector<LayoutNode::Length>& target){
+    target.resize(tracks.size());
+    for (size_t i = 0; i < tracks.size(); i++)
+    {
+        target[i] = to_layout_length(tracks[i]);
+    }
+}
+
+void ContainerBox::parse_tracks(String tracks_str, std::vector<LengthPair>& tracks, const char* property){
+    List<String> track_strings = split(tracks_str, " ", true);
+    tracks.clear();
+    tracks.reserve(track_strings.size());
+    for (size_t i = 0; i < track_strings.size(); i++)
+    {
+        tracks.push_back(parse_length(track_strings[i], property));
+    }
+}
+
+LengthPair ContainerBox::parse_length(const String& value, const char* property){
+    LengthPair pair;
+    LengthParser::Status status = LengthPair::parse(value, pair);
+    // Empty and 'auto' lengths are unset on purpose, flex and grid stretch or fit those.
+    if(status == LengthParser::PARSE_OK || status == LengthParser::PARSE_EMPTY || value.strip_edges() == "auto") return pair;
+
+    UtilityFunctions::print(get_name(), ": invalid ", property, " '", value, "', ", LengthPair::get_parse_error(status), ".");
+    return pair;
+}
+
+void ContainerBox::sync_layout_node(){
+    layout_node.kind = LayoutNode::CONTAINER;
+    layout_node.parent = parent ? &parent->layout_node : nullptr;
+    layout_node.position_type = static_cast<LayoutNode::Position>(position_type);
+    layout_node.hidden = visibility == Harmonia::OBJECT_HIDDEN;
+    layout_node.scroll_content = content_box && overflow_behaviour == Harmonia::OverflowBehaviour::SCROLL;
+
+    layout_node.width = to_layout_length(width);
+    layout_node.height = to_layout_length(height);
+    layout_node.padding_up = to_layout_length(padding_up);
+    layout_node.padding_right = to_layout_length(padding_right);
+    layout_node.padding_down = to_layout_length(padding_down);
+    layout_node.padding_left = to_layout_length(padding_left);
+    layout_node.margin_up = to_layout_length(margin_up);
+    layout_node.margin_right = to_layout_length(margin_right);
+    layout_node.margin_down = to_layout_length(margin_down);
+    layout_node.margin_left = to_layout_length(margin_left);
+    layout_node.pos_x = to_layout_length(pos_x);
+    layout_node.pos_y = to_layout_length(pos_y);
+
+    layout_node.layout_mode = static_cast<LayoutNode::LayoutMode>(layout_mode);
+    layout_node.flex_direction = static_cast<LayoutNode::FlexDirection>(flex_direction);
+    layout_node.flex_wrap = static_cast<LayoutNode::FlexWrap>(flex_wrap);
+    layout_node.justify_content = static_cast<LayoutNode::FlexJustify>(justify_content);
+    layout_node.align_items = static_cast<LayoutNode::FlexAlign>(align_items);
+    layout_node.row_gap = to_layout_length(row_gap);
+    layout_node.column_gap = to_layout_length(column_gap);
+    layout_node.flex_grow = flex_grow;
+    layout_node.flex_shrink = flex_shrink;
+    layout_node.flex_basis = to_layout_length(flex_basis);
+    to_layout_tracks(grid_columns, layout_node.grid_columns);
+    to_layout_tracks(grid_rows, layout_node.grid_rows);
+}
+
+void ContainerBox::sync_layout_children(const TypedArray<Node>& children){
+    sync_layout_node();
+    layout_node.clear_children();
+
+    // Sized up front, the layout node keeps pointers into it.
+    size_t control_count = 0;
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if(Object::cast_to<ContainerBox>(children[i]) == nullptr && Object::cast_to<Control>(children[i]) != nullptr){
+            control_count++;
+        }
+    }
+    control_layout_nodes.resize(control_count);
+
+    size_t control_index = 0;
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        auto current_child = children[i];
+        if(auto* container = Object::cast_to<ContainerBox>(current_child)){
+            container->sync_layout_node();
+            layout_node.add_child(&container->layout_node);
+        }else if(auto* control = Object::cast_to<Control>(current_child)){
+            LayoutNode& control_node = control_layout_nodes[control_index++];
+            Vector2 control_size = control->get_size();
+            control_node.kind = LayoutNode::CONTROL;
+            control_node.anchored = control->get_anchor(Side::SIDE_LEFT) != 0 || control->get_anchor(Side::SIDE_TOP) != 0
+                || control->get_anchor(Side::SIDE_RIGHT) != 0 || control->get_anchor(Side::SIDE_BOTTOM) != 0;
+            control_node.width.unit_type = LayoutNode::PIXEL;
+            control_node.width.length = control_size.x;
+            control_node.height.unit_type = LayoutNode::PIXEL;
+            control_node.height.length = control_size.y;
+            control_node.geometry_dirty = true;
+            layout_node.add_child(&control_node);
+        }
+    }
+}
+
+const LayoutNode::Geometry& ContainerBox::get_resolved_geometry(){
+    if(layout_node.geometry_dirty){
+        sync_layout_node();
+        if(parent == nullptr){
+            LayoutSolver::resolve_geometry(layout_node, window_size.x, window_size.y, window_size.x, window_size.y);
+        }else{
+            LayoutSolver::resolve_geometry(layout_node, parent->get_width(), parent->get_height(), window_size.x, window_size.y);
+        }
+    }
+    return layout_node.geometry;
+}
+
+void ContainerBox::invalidate_geometry(bool include_children){
+    layout_node.geometry_dirty = true;
+    if(!include_children) return;
+
+    // Percentage pairs of children are resolved against this containers size.
+    TypedArray<Node> children = get_layout_children();
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            container->invalidate_geometry(true);
+        }
+    }
+}
+
+void ContainerBox::begin_layout_update(){
+    layout_update_depth++;
+}
+
+void ContainerBox::commit_layout_update(){
+    if(layout_update_depth == 0){
+        UtilityFunctions::print("commit_layout_update called without begin_layout_update");
+        return;
+    }
+    if(--layout_update_depth > 0) return;
+
+    int changes = pending_layout_changes;
+    bool redraw = pending_layout_redraw;
+    pending_layout_changes = 0;
+    pending_layout_redraw = false;
+
+    // Relayout now instead of at the end of the frame, so the alert listeners see the final layout.
+    ContainerBox* root = get_root_container();
+    if(root->layout_scheduled){
+        root->flush_layout();
+    }
+    if(redraw){
+        queue_background_redraw();
+    }
+    if(changes != 0){
+        dispatch_layout_change(changes);
+    }
+}
+
+bool ContainerBox::is_layout_updating(){
+    return layout_update_depth > 0;
+}
+
+void ContainerBox::alert_layout_change(AlertLayoutChange::LayoutChanged changed, bool redraw){
+    if(layout_update_depth > 0){
+        pending_layout_changes |= AlertLayoutChange::get_change_bit(changed);
+        pending_layout_redraw = pending_layout_redraw || redraw;
+        return;
+    }
+
+    if(redraw){
+        queue_background_redraw();
+    }
+    dispatch_layout_change(AlertLayoutChange::get_change_bit(changed));
+}
+
+void ContainerBox::dispatch_layout_change(int changed_mask){
+    // A single change keeps its specific type, merged changes are only described by the mask.
+    AlertLayoutChange::LayoutChanged changed = AlertLayoutChange::UNSPECIFIED;
+    for (int i = AlertLayoutChange::UNSPECIFIED; i <= AlertLayoutChange::PADDING; i++)
+    {
+        if(changed_mask == AlertLayoutChange::get_change_bit(static_cast<AlertLayoutChange::LayoutChanged>(i))){
+            changed = static_cast<AlertLayoutChange::LayoutChanged>(i);
+        }
+    }
+    // Pooled, the alert is reused once the handlers (or a deferred alert manager) release it.
+    Ref<AlertLayoutChange> alert = AlertLayoutChange::acquire(changed, changed_mask);
+    alert->set_sender(this);
+    if(bubble_alert(alert.ptr())){
+        return; // Handled inside of the subtree.
+    }
+
+    if(alert_manager == nullptr){
+        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
+        return;
+    }
+    alert_manager->dispatch_alert(alert.ptr());
+}
+
+AlertManager* ContainerBox::get_scoped_alerts(){
+    if(scoped_alerts == nullptr){
+        scoped_alerts = memnew(AlertManager);
+    }
+    return scoped_alerts;
+}
+
+void ContainerBox::add_alert_listener(String alert_type, Callable callable){
+    get_scoped_alerts()->godot_add_bind(alert_type, callable);
+}
+
+void ContainerBox::remove_alert_listener(String alert_type, Callable callable){
+    if(scoped_alerts == nullptr) return;
+    scoped_alerts->godot_remove_bind(alert_type, callable);
+}
+
+bool ContainerBox::bubble_alert(Alert* alert){
+    if(alert == nullptr) return false;
+
+    // Walks the parents only, containers without listeners cost a pointer check.
+    alert->propagation_stopped = false;
+    for (ContainerBox* container = this; container != nullptr; container = container->parent)
+    {
+        if(container->scoped_alerts == nullptr) continue;
+        alert->set_current_target(container);
+        container->scoped_alerts->dispatch_alert_immediate(alert);
+        if(alert->propagation_stopped) break;
+    }
+    alert->set_current_target(nullptr);
+    return alert->propagation_stopped;
+}
+
 AlertManager* ContainerBox::get_alert_manager(){
     return alert_manager;
 }
@@ -385,46 +1003,135 @@ void ContainerBox::set_alert_manager(AlertManager* manager){
     alert_manager = manager;
 }
 
+void ContainerBox::set_layout_profiling(bool value){
+    LayoutProfiler::set_enabled(value);
+}
+
+bool ContainerBox::is_layout_profiling(){
+    return LayoutProfiler::is_enabled();
+}
+
+Dictionary ContainerBox::get_layout_profile(){
+    LayoutProfile subtree = layout_profile;
+    add_subtree_profiles(subtree);
+    Dictionary profile = layout_profile.to_dictionary();
+    profile["subtree"] = subtree.to_dictionary();
+    return profile;
+}
+
+void ContainerBox::add_subtree_profiles(LayoutProfile& total){
+    TypedArray<Node> children = get_layout_children();
+    for (int64_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            total.add(container->layout_profile);
+            container->add_subtree_profiles(total);
+        }
+    }
+}
+
+Array ContainerBox::get_layout_hotspots(int limit){
+    std::vector<std::pair<uint64_t, ContainerBox*>> containers;
+    collect_profiled_containers(containers);
+    std::sort(containers.begin(), containers.end(), [](const std::pair<uint64_t, ContainerBox*>& a, const std::pair<uint64_t, ContainerBox*>& b){
+        return a.first > b.first;
+    });
+
+    Array hotspots;
+    for (size_t i = 0; i < containers.size() && (limit < 0 || (int)i < limit); i++)
+    {
+        Dictionary hotspot = containers[i].second->get_layout_profile();
+        hotspot["container"] = containers[i].second;
+        hotspots.push_back(hotspot);
+    }
+    return hotspots;
+}
+
+void ContainerBox::collect_profiled_containers(std::vector<std::pair<uint64_t, ContainerBox*>>& containers){
+    if(layout_profile.relayouts > 0){
+        containers.emplace_back(layout_profile.layout_nsec, this);
+    }
+    TypedArray<Node> children = get_layout_children();
+    for (int64_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            container->collect_profiled_containers(containers);
+        }
+    }
+}
+
+void ContainerBox::reset_layout_profile(){
+    layout_profile = LayoutProfile();
+    TypedArray<Node> children = get_layout_children();
+    for (int64_t i = 0; i < children.size(); i++)
+    {
+        if(auto* container = Object::cast_to<ContainerBox>(children[i])){
+            container->reset_layout_profile();
+        }
+    }
+}
+
 void ContainerBox::update_presentation(){
+    get_root_container()->update_layout_pass(true);
+}
+
+void ContainerBox::update_layout(TypedArray<Node> children){
+    LayoutProfiler::Scope layout_scope(layout_profile, &LayoutProfile::layout_nsec);
+    LayoutProfiler::count(layout_profile, &LayoutProfile::relayouts);
+
+    // Items of a virtualized content box are sized and positioned by the content box itself.
+    bool virtualized_content = content_box && content_box->virtualized;
+    sync_layout_children(virtualized_content ? TypedArray<Node>() : children);
+    {
+        LayoutProfiler::Scope solve_scope(layout_profile, &LayoutProfile::solve_nsec);
+        LayoutSolver::layout(layout_node, window_size.x, window_size.y);
+    }
+
     if(parent == nullptr){
-        parent = get_parent_container();
-        if(parent == nullptr){
-            update_self_position();
-        }
+        update_self_position();
     }
     
-    Vector2 new_size = Vector2(calculate_total_width(), calculate_total_height());
-    update_container_overflows(content_box->get_children());
+    Vector2 new_size = Vector2(layout_node.total_width, layout_node.total_height);
+    {
+        LayoutProfiler::Scope overflow_scope(layout_profile, &LayoutProfile::overflow_nsec);
+        update_container_overflows();
+    }
     ContainerBox::set_size(new_size);
+    LayoutProfiler::count(layout_profile, &LayoutProfile::set_size_calls);
+    // Scrolled content box is moved instead of its children, children scrolled out of it must not be picked outside of this container.
+    set_clip_contents(layout_node.scroll_content);
     if(content_box){
-        update_children_position(content_box->get_children());
         content_box->set_size(Vector2(get_width(), get_height())); // Set to 100%, 100% no padding.
-        content_box->set_position(Vector2(get_padding_left(), get_padding_up()));
+        LayoutProfiler::count(layout_profile, &LayoutProfile::set_size_calls);
+        content_box->set_scroll_origin(Vector2(get_padding_left(), get_padding_up()));
 
         content_box->apply_overflowing();
         content_box->standalone = false;
+        content_box->is_overflowed_x = is_overflowed_x;
+        content_box->is_overflowed_y = is_overflowed_y;
         if(is_overflowed_x || is_overflowed_y){
-            content_box->is_overflowed_x = is_overflowed_x;
-            content_box->is_overflowed_y = is_overflowed_y;
             content_box->overflowing_size_x_px = get_overflow_x_size();
             content_box->overflowing_size_y_px = get_overflow_y_size();
             content_box->max_scroll_left_px = content_box->overflowing_size_x_px;
             content_box->max_scroll_top_px = content_box->overflowing_size_y_px;
             if(debug_outputs) UtilityFunctions::print("Scroll update: (x: ", negative_overflow_x, " y: ", negative_overflow_y, ")");
-            content_box->offset_left_px = abs(negative_overflow_x);
-            content_box->offset_top_px = abs(negative_overflow_y);
         }else{
-            content_box->is_overflowed_x = is_overflowed_x;
-            content_box->is_overflowed_y = is_overflowed_y;
             content_box->overflowing_size_x_px = 0;
             content_box->overflowing_size_y_px = 0;
             content_box->max_scroll_left_px = 0;
             content_box->max_scroll_top_px = 0;
-            content_box->offset_left_px = 0;
-            content_box->offset_top_px = 0;
         }
+        content_box->offset_left_px = layout_node.content_offset_x;
+        content_box->offset_top_px = layout_node.content_offset_y;
+    }
+
+    if(virtualized_content){
+        content_box->update_virtual_items();
+        is_overflowed_y = content_box->is_overflowed_y;
+        set_overflow_y_size(content_box->overflowing_size_y_px);
     }else{
-        update_children_position(get_children());
+        LayoutProfiler::Scope position_scope(layout_profile, &LayoutProfile::position_nsec);
+        update_children_position(children);
     }
     
     update_scrolls();
@@ -432,68 +1139,25 @@ void ContainerBox::update_presentation(){
 }
 
 void ContainerBox::update_self_position(){
-    Vector2 position = Vector2(0, 0); // scrolling here if used...
-
-    position.y += get_margin_up();
-    position.x += get_margin_left();
-
-    if(position_type == Harmonia::Position::ABSOLUTE || position_type == Harmonia::Position::RELATIVE){
-        position.y += get_pos_y();
-        position.x += get_pos_x();
-    }
-
-    set_position(position);
+    set_position(Vector2(layout_node.position_x, layout_node.position_y));
+    LayoutProfiler::count(layout_profile, &LayoutProfile::set_position_calls);
 }
 
 void ContainerBox::update_children_position(TypedArray<Node> children){
-    Vector2 position = Vector2(0, get_padding_up()); // scrolling here if used...
-
-    if(content_box && overflow_behaviour == Harmonia::OverflowBehaviour::SCROLL){
-        position.y = 0;
-        position.x += content_box->scroll_left_px + content_box->offset_left_px;
-        position.y += content_box->scroll_top_px + content_box->offset_top_px;
-    }
-
+    size_t control_index = 0;
     for (size_t i = 0; i < children.size(); i++)
     {
         auto current_child = children[i];
         if(auto* container = Object::cast_to<ContainerBox>(current_child)){
-            if(container->get_visibility() == Harmonia::OBJECT_HIDDEN) continue;
-
-            double m_up = container->get_margin_up();
-            double m_down = container->get_margin_down();
-            double m_left = container->get_margin_left();
-            double m_right = container->get_margin_right();
-            double p_up = container->get_padding_up();
-            double p_down = container->get_padding_down();
-            double p_left = container->get_padding_left();
-            double p_right = container->get_padding_right();
-
-            if(container->position_type == Harmonia::Position::STATIC){
-                position.y += m_up;
-                container->set_position(Vector2(position.x + m_left, position.y));
-                position.y += container->get_height() + m_down + p_down + p_up;
-            }else if(container->position_type == Harmonia::Position::ABSOLUTE){
-                double pos_container_x = container->get_pos_x() + m_left;
-                double pos_container_y = container->get_pos_y() + m_up;
-                container->set_position(Vector2(pos_container_x, pos_container_y));                
-            }else if(container-> position_type == Harmonia::Position::RELATIVE){
-                position.y += m_up;
-                double pos_container_x = position.x + container->get_pos_x() + m_left;
-                container->set_position(Vector2(pos_container_x, position.y + container->get_pos_y()));
-                position.y += container->get_height() + m_down + p_down + p_up;
-            }
+            if(container->layout_node.hidden) continue;
+            container->set_position(Vector2(container->layout_node.position_x, container->layout_node.position_y));
+            LayoutProfiler::count(layout_profile, &LayoutProfile::set_position_calls);
         }else if(auto* control = Object::cast_to<Control>(current_child)){
-            double side_left = control->get_anchor(Side::SIDE_LEFT);
-            double side_top = control->get_anchor(Side::SIDE_TOP);
-            double side_right = control->get_anchor(Side::SIDE_RIGHT);
-            double side_bottom = control->get_anchor(Side::SIDE_BOTTOM);
-
-            if(side_left == 0 && side_top == 0 && side_right == 0 && side_bottom == 0){
-                // When layout mode is position (this is where sides are set to 0)
-                control->set_position(Vector2(position.x + get_padding_left(), position.y));
-            }else{
-                control->set_position(Vector2(position.x, position.y));
+            const LayoutNode& control_node = control_layout_nodes[control_index++];
+            control->set_position(Vector2(control_node.position_x, control_node.position_y));
+            LayoutProfiler::count(layout_profile, &LayoutProfile::set_position_calls);
+
+            if(control_node.anchored){
                 update_control_anchors(control);
 
                 // Resets offsets to 0, this fixes the issue with content overflowing outside of the content area.
@@ -503,8 +1167,6 @@ void ContainerBox::update_children_position(TypedArray<Node> children){
                 control->set_offset(Side::SIDE_RIGHT, 0);
                 control->set_offset(Side::SIDE_BOTTOM, 0);
             }
-
-            position.y += control->get_size().y;
         }
     }
 }
@@ -572,36 +1234,33 @@ void ContainerBox::set_padding_str(String new_padding){
     int padding_size = paddings.size();
     padding_str = new_padding;
     if(padding_size == 1){
-        LengthPair padding_all = LengthPair::get_pair(new_padding);
+        LengthPair padding_all = parse_length(new_padding, "padding");
         set_padding_all(padding_all.length, padding_all.unit_type);
         if(debug_outputs) UtilityFunctions::print("Extracted 1 padding:", padding_all.length);
     }
     if(padding_size == 2){
-        LengthPair padding_y = LengthPair::get_pair(paddings[0]);
-        LengthPair padding_x = LengthPair::get_pair(paddings[1]);
+        LengthPair padding_y = parse_length(paddings[0], "padding");
+        LengthPair padding_x = parse_length(paddings[1], "padding");
         set_padding_y_vertical(padding_y.length, padding_y.unit_type, false); // false to avoid duplicate alert.
         set_padding_x_horizontal(padding_x.length, padding_x.unit_type);
         if(debug_outputs) UtilityFunctions::print("Extracted 2 paddings:", padding_y.length, padding_x.length);
     }
     if(padding_size == 3){
-        padding_up = LengthPair::get_pair(paddings[0]);
-        LengthPair padding_x = LengthPair::get_pair(paddings[1]);
-        padding_down = LengthPair::get_pair(paddings[2]);
+        padding_up = parse_length(paddings[0], "padding");
+        LengthPair padding_x = parse_length(paddings[1], "padding");
+        padding_down = parse_length(paddings[2], "padding");
         set_padding_x_horizontal(padding_x.length, padding_x.unit_type);
         if(debug_outputs) UtilityFunctions::print("Extracted 3 paddings:", padding_up.length, padding_x.length, padding_down.length);
     }
     if(padding_size == 4){
-        padding_up = LengthPair::get_pair(paddings[0]);
-        padding_right = LengthPair::get_pair(paddings[1]);
-        padding_down = LengthPair::get_pair(paddings[2]);
-        padding_left = LengthPair::get_pair(paddings[3]);
-
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
+        padding_up = parse_length(paddings[0], "padding");
+        padding_right = parse_length(paddings[1], "padding");
+        padding_down = parse_length(paddings[2], "padding");
+        padding_left = parse_length(paddings[3], "padding");
+        invalidate_geometry();
+        mark_layout_dirty();
+
+        alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
         if(debug_outputs) UtilityFunctions::print("Extracted 4 paddings:", padding_up.length, padding_right.length, padding_down.length, padding_left.length);
     }
     else{
@@ -622,15 +1281,9 @@ void ContainerBox::set_padding_all(double all_sides, Harmonia::Unit unit_type, b
     padding_down.unit_type = unit_type;
     padding_left.length = all_sides;
     padding_left.unit_type = unit_type;
-    if (dispatch_alert_and_queue)
-    {
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert_and_queue) alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
 }
 
 void ContainerBox::set_padding_y_vertical(double vertical_y, Harmonia::Unit vertical_unit, bool dispatch_alert_and_queue){
@@ -638,15 +1291,9 @@ void ContainerBox::set_padding_y_vertical(double vertical_y, Harmonia::Unit vert
     padding_up.unit_type = vertical_unit;
     padding_down.length = vertical_y;
     padding_down.unit_type = vertical_unit;
-    if (dispatch_alert_and_queue)
-    {
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert_and_queue) alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
 }
 
 void ContainerBox::set_padding_x_horizontal(double horizontal_x, Harmonia::Unit horizontal_unit, bool dispatch_alert_and_queue){
@@ -654,15 +1301,9 @@ void ContainerBox::set_padding_x_horizontal(double horizontal_x, Harmonia::Unit
     padding_right.unit_type = horizontal_unit;
     padding_left.length = horizontal_x;
     padding_left.unit_type = horizontal_unit;
-    if (dispatch_alert_and_queue)
-    {
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert_and_queue) alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
 }
 
 TypedArray<double> ContainerBox::get_paddings(Harmonia::Unit unit_type){
@@ -678,72 +1319,52 @@ TypedArray<double> ContainerBox::get_paddings(Harmonia::Unit unit_type){
 void ContainerBox::set_padding_up(double up, Harmonia::Unit up_unit, bool dispatch_alert_and_queue){
     padding_up.length = up;
     padding_up.unit_type = up_unit;
-    if (dispatch_alert_and_queue)
-    {
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert_and_queue) alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
 }
 
 double ContainerBox::get_padding_up(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().padding_up;
     return get_height_length_pair_unit(padding_up, unit_type);
 }
 
 void ContainerBox::set_padding_down(double down, Harmonia::Unit down_unit, bool dispatch_alert_and_queue){
     padding_down.length = down;
     padding_down.unit_type = down_unit;
-    if (dispatch_alert_and_queue)
-    {
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert_and_queue) alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
 }
 
 double ContainerBox::get_padding_down(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().padding_down;
     return get_height_length_pair_unit(padding_down, unit_type);
 }
 
 void ContainerBox::set_padding_left(double left, Harmonia::Unit left_unit, bool dispatch_alert_and_queue){
     padding_left.length = left;
     padding_left.unit_type = left_unit;
-    if (dispatch_alert_and_queue)
-    {
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert_and_queue) alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
 }
 
 double ContainerBox::get_padding_left(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().padding_left;
     return get_width_length_pair_unit(padding_left, unit_type);
 }
 
 void ContainerBox::set_padding_right(double right, Harmonia::Unit right_unit, bool dispatch_alert_and_queue){
     padding_right.length = right;
     padding_right.unit_type = right_unit;
-    if (dispatch_alert_and_queue)
-    {
-        if (alert_manager) {
-            alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::PADDING)));
-        } else {
-            UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-        }
-        queue_redraw();
-    }    
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert_and_queue) alert_layout_change(AlertLayoutChange::LayoutChanged::PADDING, true);
 }
 
 double ContainerBox::get_padding_right(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().padding_right;
     return get_width_length_pair_unit(padding_right, unit_type);
 }
 
@@ -752,29 +1373,31 @@ void ContainerBox::set_margin_str(String new_margin){
     int margin_size = margins.size();
     margin_str = new_margin;
     if(margin_size == 1){
-        LengthPair margin_all = LengthPair::get_pair(new_margin);
+        LengthPair margin_all = parse_length(new_margin, "margin");
         set_margin_all(margin_all.length, margin_all.unit_type);
         if(debug_outputs) UtilityFunctions::print("Extracted 1 margin:", margin_all.length);
     }
     if(margin_size == 2){
-        LengthPair margin_y = LengthPair::get_pair(margins[0]);
-        LengthPair margin_x = LengthPair::get_pair(margins[1]);
+        LengthPair margin_y = parse_length(margins[0], "margin");
+        LengthPair margin_x = parse_length(margins[1], "margin");
         set_margin_y_vertical(margin_y.length, margin_y.unit_type, false); // false to avoid duplicate alert.
         set_margin_x_horizontal(margin_x.length, margin_x.unit_type);
         if(debug_outputs) UtilityFunctions::print("Extracted 2 margins:", margin_y.length, margin_x.length);
     }
     if(margin_size == 3){
-        margin_up = LengthPair::get_pair(margins[0]);
-        LengthPair margin_x = LengthPair::get_pair(margins[1]);
-        margin_down = LengthPair::get_pair(margins[2]);
+        margin_up = parse_length(margins[0], "margin");
+        LengthPair margin_x = parse_length(margins[1], "margin");
+        margin_down = parse_length(margins[2], "margin");
         set_margin_x_horizontal(margin_x.length, margin_x.unit_type);
         if(debug_outputs) UtilityFunctions::print("Extracted 3 margins:", margin_up.length, margin_x.length, margin_down.length);
     }
     if(margin_size == 4){
-        margin_up = LengthPair::get_pair(margins[0]);
-        margin_right = LengthPair::get_pair(margins[1]);
-        margin_down = LengthPair::get_pair(margins[2]);
-        margin_left = LengthPair::get_pair(margins[3]);
+        margin_up = parse_length(margins[0], "margin");
+        margin_right = parse_length(margins[1], "margin");
+        margin_down = parse_length(margins[2], "margin");
+        margin_left = parse_length(margins[3], "margin");
+        invalidate_geometry();
+        mark_layout_dirty();
         if(debug_outputs) UtilityFunctions::print("Extracted 4 margins:", margin_up.length, margin_right.length, margin_down.length, margin_left.length);
     }
     else{
@@ -795,11 +1418,9 @@ void ContainerBox::set_margin_all(double all_sides, Harmonia::Unit unit_type, bo
     margin_down.unit_type = unit_type;
     margin_left.length = all_sides;
     margin_left.unit_type = unit_type;
-    if (alert_manager) {
-        if (dispatch_alert) alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::MARGIN)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert) alert_layout_change(AlertLayoutChange::LayoutChanged::MARGIN);
 }
 
 void ContainerBox::set_margin_y_vertical(double vertical_y, Harmonia::Unit vertical_unit, bool dispatch_alert){
@@ -807,11 +1428,9 @@ void ContainerBox::set_margin_y_vertical(double vertical_y, Harmonia::Unit verti
     margin_up.unit_type = vertical_unit;
     margin_down.length = vertical_y;
     margin_down.unit_type = vertical_unit;
-    if (alert_manager) {
-        if (dispatch_alert) alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::MARGIN)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert) alert_layout_change(AlertLayoutChange::LayoutChanged::MARGIN);
 }
 
 void ContainerBox::set_margin_x_horizontal(double horizontal_x, Harmonia::Unit horizontal_unit, bool dispatch_alert){
@@ -819,11 +1438,9 @@ void ContainerBox::set_margin_x_horizontal(double horizontal_x, Harmonia::Unit h
     margin_right.unit_type = horizontal_unit;
     margin_left.length = horizontal_x;
     margin_left.unit_type = horizontal_unit;
-    if (alert_manager) {
-        if (dispatch_alert) alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::MARGIN)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert) alert_layout_change(AlertLayoutChange::LayoutChanged::MARGIN);
 }
 
 TypedArray<double> ContainerBox::get_margins(Harmonia::Unit unit_type){
@@ -839,55 +1456,51 @@ TypedArray<double> ContainerBox::get_margins(Harmonia::Unit unit_type){
 void ContainerBox::set_margin_up(double up, Harmonia::Unit up_unit, bool dispatch_alert){
     margin_up.length = up;
     margin_up.unit_type = up_unit;
-    if (alert_manager) {
-        if (dispatch_alert) alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::MARGIN)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert) alert_layout_change(AlertLayoutChange::LayoutChanged::MARGIN);
 }
 
 double ContainerBox::get_margin_up(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().margin_up;
     return get_height_length_pair_unit(margin_up, unit_type);
 }
 
 void ContainerBox::set_margin_down(double down, Harmonia::Unit down_unit, bool dispatch_alert){
     margin_down.length = down;
     margin_down.unit_type = down_unit;
-    if (alert_manager) {
-        if (dispatch_alert) alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::MARGIN)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert) alert_layout_change(AlertLayoutChange::LayoutChanged::MARGIN);
 }
 
 double ContainerBox::get_margin_down(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().margin_down;
     return get_height_length_pair_unit(margin_down, unit_type);
 }
 
 void ContainerBox::set_margin_left(double left, Harmonia::Unit left_unit, bool dispatch_alert){
     margin_left.length = left;
     margin_left.unit_type = left_unit;
-    if (alert_manager) {
-        if (dispatch_alert) alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::MARGIN)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert) alert_layout_change(AlertLayoutChange::LayoutChanged::MARGIN);
 }
 double ContainerBox::get_margin_left(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().margin_left;
     return get_width_length_pair_unit(margin_left, unit_type);
 }
 
 void ContainerBox::set_margin_right(double right, Harmonia::Unit right_unit, bool dispatch_alert){
     margin_right.length = right;
     margin_right.unit_type = right_unit;
-    if (alert_manager) {
-        if (dispatch_alert) alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::MARGIN)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    if (dispatch_alert) alert_layout_change(AlertLayoutChange::LayoutChanged::MARGIN);
 }
 
 double ContainerBox::get_margin_right(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().margin_right;
     return get_width_length_pair_unit(margin_right, unit_type);
 }
 
@@ -897,11 +1510,16 @@ Color ContainerBox::get_background_color(){
 
 void ContainerBox::set_background_color(Color color){
     background_color = color;
-    queue_redraw();
+    if(layout_update_depth > 0){
+        pending_layout_redraw = true;
+    }else{
+        queue_background_redraw();
+    }
 }
 
 void ContainerBox::set_position_type(Harmonia::Position new_type){
     position_type = new_type;
+    mark_layout_dirty();
 }
 Harmonia::Position ContainerBox::get_position_type(){
     return position_type;
@@ -912,6 +1530,7 @@ void ContainerBox::set_overflow_behaviour(Harmonia::OverflowBehaviour behaviour)
         content_box->overflowing_behaviour = behaviour;
     }
     overflow_behaviour = behaviour;
+    mark_layout_dirty();
 }
 
 Harmonia::OverflowBehaviour ContainerBox::get_overflow_behaviour(){
@@ -921,20 +1540,19 @@ Harmonia::OverflowBehaviour ContainerBox::get_overflow_behaviour(){
 void ContainerBox::set_pos_x(double new_x, Harmonia::Unit unit_type){
     pos_x.length = new_x;
     pos_x.unit_type = unit_type;
-    if (alert_manager) {
-        alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::POSITION)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    alert_layout_change(AlertLayoutChange::LayoutChanged::POSITION);
 }
 
 double ContainerBox::get_pos_x(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().pos_x;
     return get_width_length_pair_unit(pos_x, unit_type);
 }
 
 void ContainerBox::set_pos_x_str(String new_x){
     pos_x_str = new_x;
-    LengthPair pos_x = LengthPair::get_pair(new_x);
+    LengthPair pos_x = parse_length(new_x, "pos x");
     set_pos_x(pos_x.length, pos_x.unit_type);
 }
 
@@ -945,20 +1563,19 @@ String ContainerBox::get_pos_x_str(){
 void ContainerBox::set_pos_y(double new_y, Harmonia::Unit unit_type){
     pos_y.length = new_y;
     pos_y.unit_type = unit_type;
-    if (alert_manager) {
-        alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::POSITION)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry();
+    mark_layout_dirty();
+    alert_layout_change(AlertLayoutChange::LayoutChanged::POSITION);
 }
 
 double ContainerBox::get_pos_y(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().pos_y;
     return get_height_length_pair_unit(pos_y, unit_type);
 }
 
 void ContainerBox::set_pos_y_str(String new_y){
     pos_y_str = new_y;
-    LengthPair pos_y = LengthPair::get_pair(new_y);
+    LengthPair pos_y = parse_length(new_y, "pos y");
     set_pos_y(pos_y.length, pos_y.unit_type);
 }
 
@@ -966,6 +1583,165 @@ String ContainerBox::get_pos_y_str(){
     return pos_y_str;
 }
 
+void ContainerBox::set_layout_mode(Harmonia::LayoutMode new_mode){
+    layout_mode = new_mode;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+Harmonia::LayoutMode ContainerBox::get_layout_mode(){
+    return layout_mode;
+}
+
+void ContainerBox::set_grid_columns_str(String tracks){
+    grid_columns_str = tracks;
+    parse_tracks(tracks, grid_columns, "grid column");
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+String ContainerBox::get_grid_columns_str(){
+    return grid_columns_str;
+}
+
+void ContainerBox::set_grid_rows_str(String tracks){
+    grid_rows_str = tracks;
+    parse_tracks(tracks, grid_rows, "grid row");
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+String ContainerBox::get_grid_rows_str(){
+    return grid_rows_str;
+}
+
+void ContainerBox::set_flex_direction(Harmonia::FlexDirection new_direction){
+    flex_direction = new_direction;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+Harmonia::FlexDirection ContainerBox::get_flex_direction(){
+    return flex_direction;
+}
+
+void ContainerBox::set_flex_wrap(Harmonia::FlexWrap new_wrap){
+    flex_wrap = new_wrap;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+Harmonia::FlexWrap ContainerBox::get_flex_wrap(){
+    return flex_wrap;
+}
+
+void ContainerBox::set_justify_content(Harmonia::FlexJustify new_justify){
+    justify_content = new_justify;
+    mark_layout_dirty();
+}
+
+Harmonia::FlexJustify ContainerBox::get_justify_content(){
+    return justify_content;
+}
+
+void ContainerBox::set_align_items(Harmonia::FlexAlign new_align){
+    align_items = new_align;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+Harmonia::FlexAlign ContainerBox::get_align_items(){
+    return align_items;
+}
+
+void ContainerBox::set_row_gap(double length, Harmonia::Unit unit_type){
+    row_gap.length = length;
+    row_gap.unit_type = unit_type;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+double ContainerBox::get_row_gap(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::NOT_SET) return 0;
+    return ContainerUnitConverter::get_height(row_gap, get_height(), window_size, unit_type);
+}
+
+void ContainerBox::set_row_gap_str(String length_and_unit){
+    row_gap_str = length_and_unit;
+    LengthPair pair = parse_length(length_and_unit, "row gap");
+    set_row_gap(pair.length, pair.unit_type);
+}
+
+String ContainerBox::get_row_gap_str(){
+    return row_gap_str;
+}
+
+void ContainerBox::set_column_gap(double length, Harmonia::Unit unit_type){
+    column_gap.length = length;
+    column_gap.unit_type = unit_type;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+double ContainerBox::get_column_gap(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::NOT_SET) return 0;
+    return ContainerUnitConverter::get_width(column_gap, get_width(), window_size, unit_type);
+}
+
+void ContainerBox::set_column_gap_str(String length_and_unit){
+    column_gap_str = length_and_unit;
+    LengthPair pair = parse_length(length_and_unit, "column gap");
+    set_column_gap(pair.length, pair.unit_type);
+}
+
+String ContainerBox::get_column_gap_str(){
+    return column_gap_str;
+}
+
+void ContainerBox::set_flex_grow(double new_grow){
+    flex_grow = new_grow > 0 ? new_grow : 0;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+double ContainerBox::get_flex_grow(){
+    return flex_grow;
+}
+
+void ContainerBox::set_flex_shrink(double new_shrink){
+    flex_shrink = new_shrink > 0 ? new_shrink : 0;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+double ContainerBox::get_flex_shrink(){
+    return flex_shrink;
+}
+
+void ContainerBox::set_flex_basis(double length, Harmonia::Unit unit_type){
+    flex_basis.length = length;
+    flex_basis.unit_type = unit_type;
+    invalidate_geometry(true);
+    mark_layout_dirty();
+}
+
+double ContainerBox::get_flex_basis(Harmonia::Unit unit_type){
+    if(parent != nullptr && (parent->flex_direction == Harmonia::FLEX_COLUMN || parent->flex_direction == Harmonia::FLEX_COLUMN_REVERSE)){
+        return get_height_length_pair_unit(flex_basis, unit_type);
+    }
+    return get_width_length_pair_unit(flex_basis, unit_type);
+}
+
+void ContainerBox::set_flex_basis_str(String length_and_unit){
+    flex_basis_str = length_and_unit;
+    LengthPair pair = parse_length(length_and_unit, "flex basis");
+    set_flex_basis(pair.length, pair.unit_type);
+}
+
+String ContainerBox::get_flex_basis_str(){
+    return flex_basis_str;
+}
+
 void ContainerBox::set_debug_outputs(bool debug_outputs)
 {
     ContainerBox::debug_outputs = debug_outputs;
@@ -977,26 +1753,25 @@ bool ContainerBox::get_debug_outputs()
 }
 
 double ContainerBox::get_width(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().width;
     return get_width_length_pair_unit(width, unit_type);
 }
 
 double ContainerBox::calculate_total_width(Harmonia::Unit unit_type){
-    return get_width_length_pair_unit(width, unit_type) + get_padding_left(unit_type) + get_padding_right(unit_type);
+    return get_width(unit_type) + get_padding_left(unit_type) + get_padding_right(unit_type);
 }
 
 void ContainerBox::set_width(double length, Harmonia::Unit unit_type){
     ContainerBox::width.length = length;
     ContainerBox::width.unit_type = unit_type;
-    if (alert_manager) {
-        alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::WIDTH)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry(true);
+    mark_layout_dirty();
+    alert_layout_change(AlertLayoutChange::LayoutChanged::WIDTH);
 }
 
 void ContainerBox::set_width_str(String length_and_unit){
     width_str = length_and_unit;
-    LengthPair pair = LengthPair::get_pair(length_and_unit);
+    LengthPair pair = parse_length(length_and_unit, "width");
     set_width(pair.length, pair.unit_type);
 }
 
@@ -1008,16 +1783,14 @@ String ContainerBox::get_width_str()
 void ContainerBox::set_height(double length, Harmonia::Unit unit_type){
     ContainerBox::height.length = length;
     ContainerBox::height.unit_type = unit_type;
-    if (alert_manager) {
-        alert_manager->dispatch_alert(memnew(AlertLayoutChange(ALERT_LAYOUT_CHANGE, AlertLayoutChange::LayoutChanged::HEIGHT)));
-    } else {
-        UtilityFunctions::print("Alert manager is null! Cannot dispatch alert");
-    }
+    invalidate_geometry(true);
+    mark_layout_dirty();
+    alert_layout_change(AlertLayoutChange::LayoutChanged::HEIGHT);
 }
 
 void ContainerBox::set_height_str(String length_and_unit){
     height_str = length_and_unit; 
-    LengthPair pair = LengthPair::get_pair(length_and_unit);
+    LengthPair pair = parse_length(length_and_unit, "height");
     set_height(pair.length, pair.unit_type);
 }
 
@@ -1027,25 +1800,44 @@ String ContainerBox::get_height_str()
 }
 
 double ContainerBox::get_height(Harmonia::Unit unit_type){
+    if(unit_type == Harmonia::Unit::PIXEL) return get_resolved_geometry().height;
     return get_height_length_pair_unit(height, unit_type);
 }
 
 double ContainerBox::calculate_total_height(Harmonia::Unit unit_type){
-    return get_height_length_pair_unit(height, unit_type) + get_padding_up(unit_type) + get_padding_down(unit_type);
+    return get_height(unit_type) + get_padding_up(unit_type) + get_padding_down(unit_type);
 }
 
 void ContainerBox::_notification(int p_what)
 {
     if(p_what == NOTIFICATION_READY){
         _ready();
-    }else if(p_what == NOTIFICATION_PROCESS){
-        _process(get_process_delta_time());
     }else if(p_what == NOTIFICATION_RESIZED){
         // Process to convert new size to current unit size.
     }else if(p_what == NOTIFICATION_DRAW){
         draw_ui();
     }else if (p_what == NOTIFICATION_PARENTED){
         parent = get_parent_container();
+        if(parent && !background_batches.empty()){
+            // No longer a root, the new root draws (or doesn't batch) the backgrounds of this tree.
+            free_background_batches();
+            redraw_backgrounds();
+        }
+        invalidate_geometry(true);
+        mark_layout_dirty();
+    }else if (p_what == NOTIFICATION_UNPARENTED){
+        parent = nullptr;
+        layout_node.parent = nullptr;
+        invalidate_geometry(true);
+        mark_layout_dirty();
+    }else if (p_what == NOTIFICATION_PREDELETE){
+        free_background_batches();
+        if(scoped_alerts){
+            memdelete(scoped_alerts);
+            scoped_alerts = nullptr;
+        }
+    }else if (p_what == NOTIFICATION_CHILD_ORDER_CHANGED){
+        on_children_changed();
     }
 }
 
@@ -1055,6 +1847,16 @@ void ContainerBox::_bind_methods(){
     ClassDB::bind_method(D_METHOD("get_visibility"), &ContainerBox::get_visibility);
 
     ClassDB::bind_method(D_METHOD("on_window_size_changed"), &ContainerBox::on_window_size_changed);
+    ClassDB::bind_method(D_METHOD("on_children_changed"), &ContainerBox::on_children_changed);
+    ClassDB::bind_method(D_METHOD("flush_layout"), &ContainerBox::flush_layout);
+    ClassDB::bind_method(D_METHOD("mark_layout_dirty"), &ContainerBox::mark_layout_dirty);
+    ClassDB::bind_method(D_METHOD("begin_layout_update"), &ContainerBox::begin_layout_update);
+    ClassDB::bind_method(D_METHOD("commit_layout_update"), &ContainerBox::commit_layout_update);
+    ClassDB::bind_method(D_METHOD("is_layout_updating"), &ContainerBox::is_layout_updating);
+    ClassDB::bind_method(D_METHOD("pick", "global_point"), &ContainerBox::pick);
+    ClassDB::bind_method(D_METHOD("get_scrollable_at", "global_point"), &ContainerBox::get_scrollable_at);
+    ClassDB::bind_method(D_METHOD("set_culling", "value"), &ContainerBox::set_culling);
+    ClassDB::bind_method(D_METHOD("get_culling"), &ContainerBox::get_culling);
 
     ClassDB::bind_method(D_METHOD("set_width", "length", "unit_type"), &ContainerBox::set_width);
     ClassDB::bind_method(D_METHOD("get_width", "unit_type"), &ContainerBox::get_width);
@@ -1071,6 +1873,14 @@ void ContainerBox::_bind_methods(){
 
     ClassDB::bind_method(D_METHOD("set_alert_manager", "manager"), &ContainerBox::set_alert_manager);
     ClassDB::bind_method(D_METHOD("get_alert_manager"), &ContainerBox::get_alert_manager);
+    ClassDB::bind_static_method("ContainerBox", D_METHOD("set_layout_profiling", "value"), &ContainerBox::set_layout_profiling);
+    ClassDB::bind_static_method("ContainerBox", D_METHOD("is_layout_profiling"), &ContainerBox::is_layout_profiling);
+    ClassDB::bind_method(D_METHOD("get_layout_profile"), &ContainerBox::get_layout_profile);
+    ClassDB::bind_method(D_METHOD("get_layout_hotspots", "limit"), &ContainerBox::get_layout_hotspots, DEFVAL(10));
+    ClassDB::bind_method(D_METHOD("reset_layout_profile"), &ContainerBox::reset_layout_profile);
+    ClassDB::bind_method(D_METHOD("add_alert_listener", "alert_type", "callable"), &ContainerBox::add_alert_listener);
+    ClassDB::bind_method(D_METHOD("remove_alert_listener", "alert_type", "callable"), &ContainerBox::remove_alert_listener);
+    ClassDB::bind_method(D_METHOD("bubble_alert", "alert"), &ContainerBox::bubble_alert);
 
     ClassDB::bind_method(D_METHOD("set_position_type", "new_type"), &ContainerBox::set_position_type);
     ClassDB::bind_method(D_METHOD("get_position_type"), &ContainerBox::get_position_type);
@@ -1087,6 +1897,39 @@ void ContainerBox::_bind_methods(){
 
     ClassDB::bind_method(D_METHOD("set_overflow_behaviour", "behaviour"), &ContainerBox::set_overflow_behaviour);
     ClassDB::bind_method(D_METHOD("get_overflow_behaviour"), &ContainerBox::get_overflow_behaviour);
+
+    ClassDB::bind_method(D_METHOD("set_layout_mode", "new_mode"), &ContainerBox::set_layout_mode);
+    ClassDB::bind_method(D_METHOD("get_layout_mode"), &ContainerBox::get_layout_mode);
+    ClassDB::bind_method(D_METHOD("set_grid_columns_str", "tracks"), &ContainerBox::set_grid_columns_str);
+    ClassDB::bind_method(D_METHOD("get_grid_columns_str"), &ContainerBox::get_grid_columns_str);
+    ClassDB::bind_method(D_METHOD("set_grid_rows_str", "tracks"), &ContainerBox::set_grid_rows_str);
+    ClassDB::bind_method(D_METHOD("get_grid_rows_str"), &ContainerBox::get_grid_rows_str);
+    ClassDB::bind_method(D_METHOD("set_flex_direction", "new_direction"), &ContainerBox::set_flex_direction);
+    ClassDB::bind_method(D_METHOD("get_flex_direction"), &ContainerBox::get_flex_direction);
+    ClassDB::bind_method(D_METHOD("set_flex_wrap", "new_wrap"), &ContainerBox::set_flex_wrap);
+    ClassDB::bind_method(D_METHOD("get_flex_wrap"), &ContainerBox::get_flex_wrap);
+    ClassDB::bind_method(D_METHOD("set_justify_content", "new_justify"), &ContainerBox::set_justify_content);
+    ClassDB::bind_method(D_METHOD("get_justify_content"), &ContainerBox::get_justify_content);
+    ClassDB::bind_method(D_METHOD("set_align_items", "new_align"), &ContainerBox::set_align_items);
+    ClassDB::bind_method(D_METHOD("get_align_items"), &ContainerBox::get_align_items);
+
+    ClassDB::bind_method(D_METHOD("set_row_gap", "length", "unit_type"), &ContainerBox::set_row_gap, DEFVAL(Harmonia::PIXEL));
+    ClassDB::bind_method(D_METHOD("get_row_gap", "unit_type"), &ContainerBox::get_row_gap, DEFVAL(Harmonia::PIXEL));
+    ClassDB::bind_method(D_METHOD("set_row_gap_str", "length_and_unit"), &ContainerBox::set_row_gap_str);
+    ClassDB::bind_method(D_METHOD("get_row_gap_str"), &ContainerBox::get_row_gap_str);
+    ClassDB::bind_method(D_METHOD("set_column_gap", "length", "unit_type"), &ContainerBox::set_column_gap, DEFVAL(Harmonia::PIXEL));
+    ClassDB::bind_method(D_METHOD("get_column_gap", "unit_type"), &ContainerBox::get_column_gap, DEFVAL(Harmonia::PIXEL));
+    ClassDB::bind_method(D_METHOD("set_column_gap_str", "length_and_unit"), &ContainerBox::set_column_gap_str);
+    ClassDB::bind_method(D_METHOD("get_column_gap_str"), &ContainerBox::get_column_gap_str);
+
+    ClassDB::bind_method(D_METHOD("set_flex_grow", "new_grow"), &ContainerBox::set_flex_grow);
+    ClassDB::bind_method(D_METHOD("get_flex_grow"), &ContainerBox::get_flex_grow);
+    ClassDB::bind_method(D_METHOD("set_flex_shrink", "new_shrink"), &ContainerBox::set_flex_shrink);
+    ClassDB::bind_method(D_METHOD("get_flex_shrink"), &ContainerBox::get_flex_shrink);
+    ClassDB::bind_method(D_METHOD("set_flex_basis", "length", "unit_type"), &ContainerBox::set_flex_basis, DEFVAL(Harmonia::PIXEL));
+    ClassDB::bind_method(D_METHOD("get_flex_basis", "unit_type"), &ContainerBox::get_flex_basis, DEFVAL(Harmonia::PIXEL));
+    ClassDB::bind_method(D_METHOD("set_flex_basis_str", "length_and_unit"), &ContainerBox::set_flex_basis_str);
+    ClassDB::bind_method(D_METHOD("get_flex_basis_str"), &ContainerBox::get_flex_basis_str);
     
     ClassDB::bind_method(D_METHOD("set_horizontal_scroll", "scroll"), &ContainerBox::set_horizontal_scroll);
     ClassDB::bind_method(D_METHOD("get_horizontal_scroll"), &ContainerBox::get_horizontal_scroll);
@@ -1131,12 +1974,20 @@ void ContainerBox::_bind_methods(){
 
     ClassDB::bind_method(D_METHOD("set_background_color", "color"), &ContainerBox::set_background_color);
     ClassDB::bind_method(D_METHOD("get_background_color"), &ContainerBox::get_background_color);
+    ClassDB::bind_method(D_METHOD("set_batch_backgrounds", "value"), &ContainerBox::set_batch_backgrounds);
+    ClassDB::bind_method(D_METHOD("get_batch_backgrounds"), &ContainerBox::get_batch_backgrounds);
+    ClassDB::bind_method(D_METHOD("flush_backgrounds"), &ContainerBox::flush_backgrounds);
 
     ClassDB::bind_method(D_METHOD("update_presentation"), &ContainerBox::update_presentation);
 
     const String visibility_types = "VISIBLE:0,HIDDEN:1,TRANSPARENT:2";
     const String positioning_types = "STATIC:0,ABSOLUTE:1,RELATIVE:2";
     const String overflow_behaviours = "SCROLL:0,HIDDEN:1,VISIBLE:2";
+    const String layout_modes = "BLOCK:0,FLEX:1,GRID:2";
+    const String flex_directions = "ROW:0,ROW_REVERSE:1,COLUMN:2,COLUMN_REVERSE:3";
+    const String flex_wraps = "NO_WRAP:0,WRAP:1";
+    const String flex_justifies = "START:0,END:1,CENTER:2,SPACE_BETWEEN:3,SPACE_AROUND:4,SPACE_EVENLY:5";
+    const String flex_aligns = "START:0,END:1,CENTER:2,STRETCH:3";
 
     ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility", PROPERTY_HINT_ENUM, visibility_types, PROPERTY_USAGE_DEFAULT), "set_visibility", "get_visibility");
     ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "alert_manager", PROPERTY_HINT_RESOURCE_TYPE, "alert_manager", PROPERTY_USAGE_NO_EDITOR), "set_alert_manager", "get_alert_manager");
@@ -1154,6 +2005,20 @@ void ContainerBox::_bind_methods(){
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "margin_str", PROPERTY_HINT_TYPE_STRING, "margin_str", PROPERTY_USAGE_NO_EDITOR), "set_margin_str", "get_margin_str");
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "padding_str", PROPERTY_HINT_TYPE_STRING, "padding_str", PROPERTY_USAGE_NO_EDITOR), "set_padding_str", "get_padding_str");
     ADD_PROPERTY(PropertyInfo(Variant::COLOR, "background_color", PROPERTY_HINT_NONE, "background_color", PROPERTY_USAGE_NO_EDITOR), "set_background_color", "get_background_color");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "layout_mode", PROPERTY_HINT_ENUM, layout_modes, PROPERTY_USAGE_DEFAULT), "set_layout_mode", "get_layout_mode");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "grid_columns_str", PROPERTY_HINT_TYPE_STRING, "grid_columns_str", PROPERTY_USAGE_NO_EDITOR), "set_grid_columns_str", "get_grid_columns_str");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "grid_rows_str", PROPERTY_HINT_TYPE_STRING, "grid_rows_str", PROPERTY_USAGE_NO_EDITOR), "set_grid_rows_str", "get_grid_rows_str");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "flex_direction", PROPERTY_HINT_ENUM, flex_directions, PROPERTY_USAGE_DEFAULT), "set_flex_direction", "get_flex_direction");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "flex_wrap", PROPERTY_HINT_ENUM, flex_wraps, PROPERTY_USAGE_DEFAULT), "set_flex_wrap", "get_flex_wrap");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "justify_content", PROPERTY_HINT_ENUM, flex_justifies, PROPERTY_USAGE_DEFAULT), "set_justify_content", "get_justify_content");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "align_items", PROPERTY_HINT_ENUM, flex_aligns, PROPERTY_USAGE_DEFAULT), "set_align_items", "get_align_items");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "row_gap_str", PROPERTY_HINT_TYPE_STRING, "row_gap_str", PROPERTY_USAGE_NO_EDITOR), "set_row_gap_str", "get_row_gap_str");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "column_gap_str", PROPERTY_HINT_TYPE_STRING, "column_gap_str", PROPERTY_USAGE_NO_EDITOR), "set_column_gap_str", "get_column_gap_str");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "flex_grow", PROPERTY_HINT_RANGE, "0,100,0.01,or_greater", PROPERTY_USAGE_DEFAULT), "set_flex_grow", "get_flex_grow");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "flex_shrink", PROPERTY_HINT_RANGE, "0,100,0.01,or_greater", PROPERTY_USAGE_DEFAULT), "set_flex_shrink", "get_flex_shrink");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "culling"), "set_culling", "get_culling");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "batch_backgrounds"), "set_batch_backgrounds", "get_batch_backgrounds");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "flex_basis_str", PROPERTY_HINT_TYPE_STRING, "flex_basis_str", PROPERTY_USAGE_NO_EDITOR), "set_flex_basis_str", "get_flex_basis_str");
 }
 
 bool ContainerBox::_set(const StringName &p_name, const Variant &p_value)
@@ -1189,6 +2054,21 @@ bool ContainerBox::_set(const StringName &p_name, const Variant &p_value)
     }else if(name=="string_scroll_y_step"){
         set_string_scroll_y_step(p_value);
         return true;
+    }else if(name == "row_gap_str"){
+        set_row_gap_str(p_value);
+        return true;
+    }else if(name == "column_gap_str"){
+        set_column_gap_str(p_value);
+        return true;
+    }else if(name == "flex_basis_str"){
+        set_flex_basis_str(p_value);
+        return true;
+    }else if(name == "grid_columns_str"){
+        set_grid_columns_str(p_value);
+        return true;
+    }else if(name == "grid_rows_str"){
+        set_grid_rows_str(p_value);
+        return true;
     }
 	return false;
 }
@@ -1226,6 +2106,21 @@ bool ContainerBox::_get(const StringName &p_name, Variant &r_ret) const
     }else if(name=="string_scroll_y_step"){
         r_ret = string_scroll_y_step;
         return true;
+    }else if(name == "row_gap_str"){
+        r_ret = row_gap_str;
+        return true;
+    }else if(name == "column_gap_str"){
+        r_ret = column_gap_str;
+        return true;
+    }else if(name == "flex_basis_str"){
+        r_ret = flex_basis_str;
+        return true;
+    }else if(name == "grid_columns_str"){
+        r_ret = grid_columns_str;
+        return true;
+    }else if(name == "grid_rows_str"){
+        r_ret = grid_rows_str;
+        return true;
     }
 	return false;
 }
@@ -1242,4 +2137,9 @@ void ContainerBox::_get_property_list(List<PropertyInfo> *p_list) const
     p_list->push_back(PropertyInfo(Variant::BOOL, "debug_outputs"));
     p_list->push_back(PropertyInfo(Variant::STRING, "pos_x_str"));
     p_list->push_back(PropertyInfo(Variant::STRING, "pos_y_str"));
+    p_list->push_back(PropertyInfo(Variant::STRING, "row_gap_str"));
+    p_list->push_back(PropertyInfo(Variant::STRING, "column_gap_str"));
+    p_list->push_back(PropertyInfo(Variant::STRING, "flex_basis_str"));
+    p_list->push_back(PropertyInfo(Variant::STRING, "grid_columns_str"));
+    p_list->push_back(PropertyInfo(Variant::STRING, "grid_rows_str"));
 }
@@ -1,59 +1,73 @@
 #include "containers/content_box.h"
 #include <godot_cpp/classes/input_event_mouse_button.hpp>
+#include <godot_cpp/classes/input_event_pan_gesture.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/classes/v_scroll_bar.hpp>
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include "containers/container_box.h"
+#include <algorithm>
 
 void ContentBox::apply_overflowing(){
     if(is_overflowed_y || is_overflowed_x){
         if(overflowing_behaviour == Harmonia::OverflowBehaviour::HIDDEN){
-            set_clip_contents(true);
+            clipping = true;
         }else if(overflowing_behaviour == Harmonia::OverflowBehaviour::SCROLL){
-            set_clip_contents(true);
+            clipping = true;
         }else if(overflowing_behaviour == Harmonia::OverflowBehaviour::VISIBLE){
-            set_clip_contents(false);
+            clipping = false;
         }
     }
+
+    // clip_contents would clip (and pick) the moved area, clipping goes through the rendering server instead (see apply_scroll_offset)
+    if(is_clipping_contents()){
+        set_clip_contents(false);
+    }
+    apply_scroll_offset();
 }
 
-void ContentBox::apply_scrolling(double step_x, double step_y){
-    if(step_y < 0 && scroll_top_px == -max_scroll_top_px) return;
-    else if(step_y > 0 && scroll_top_px == min_scroll_top_px) return;
+void ContentBox::set_scroll_origin(Vector2 origin){
+    scroll_origin = origin;
+    apply_scroll_offset();
+}
 
-    if(step_x < 0 && scroll_left_px == -max_scroll_left_px) return;
-    else if(step_x > 0 && scroll_left_px == min_scroll_left_px) return;
+void ContentBox::apply_scroll_offset(){
+    set_position(scroll_origin + Vector2(scroll_left_px, scroll_top_px));
+    apply_scroll_clip();
+}
 
-    TypedArray<Node> children = get_children();
-    if(step_y < 0 && scroll_top_px - step_y < -max_scroll_top_px){
-        step_y = fabs(max_scroll_top_px + scroll_top_px);
-    }else if(step_y > 0 && scroll_top_px + step_y > min_scroll_top_px){
-        step_y = min_scroll_top_px - (scroll_top_px + step_y);
-    }
+void ContentBox::apply_scroll_clip(){
+    RID canvas_item = get_canvas_item();
+    RenderingServer* rendering_server = RenderingServer::get_singleton();
+    rendering_server->canvas_item_set_custom_rect(canvas_item, clipping, Rect2(Vector2(-scroll_left_px, -scroll_top_px), get_size()));
+    rendering_server->canvas_item_set_clip(canvas_item, clipping);
+}
 
-    if(step_x < 0 && scroll_left_px - step_x < -max_scroll_left_px){
-        step_x = fabs(max_scroll_left_px + scroll_left_px);
-    }else if(step_x > 0 && scroll_left_px + step_x > min_scroll_left_px){
-        step_x = min_scroll_left_px - (scroll_left_px + step_x);
-    }
+bool ContentBox::_has_point(const Vector2 &p_point) const {
+    return Rect2(Vector2(-scroll_left_px, -scroll_top_px), get_size()).has_point(p_point);
+}
 
-    set_scroll_top_px(scroll_top_px+step_y);
-    set_scroll_left_px(scroll_left_px+step_x);
+void ContentBox::apply_scrolling(double step_x, double step_y){
+    // Scroll offsets are negative, content moves up and left by up to the overflowing size.
+    double new_scroll_top_px = std::clamp(scroll_top_px + step_y, -max_scroll_top_px, min_scroll_top_px);
+    double new_scroll_left_px = std::clamp(scroll_left_px + step_x, -max_scroll_left_px, min_scroll_left_px);
+    if(new_scroll_top_px == scroll_top_px && new_scroll_left_px == scroll_left_px) return;
 
-    for (size_t i = 0; i < children.size(); i++)
-    {
-        if(auto* child = Object::cast_to<Control>(children[i])){
-            Vector2 child_position = child->get_position();
-            
-            if(is_overflowed_y){
-                child_position.y += step_y;
-                child->set_position(Vector2(child_position.x, child_position.y));
-            }
+    set_scroll_top_px(new_scroll_top_px);
+    set_scroll_left_px(new_scroll_left_px);
 
-            if(is_overflowed_x){
-                child->set_position(Vector2(child_position.x + step_x, child_position.y));
-            }
+    // Children keep their positions, only this box moves.
+    apply_scroll_offset();
+
+    if(virtualized){
+        update_virtual_items(); // Only items entering or leaving the view are touched.
+    }
+
+    if(!standalone){
+        if(auto* container = Object::cast_to<ContainerBox>(get_parent())){
+            container->on_content_scrolled();
         }
-    } 
+    }
 }
 
 void ContentBox::set_scroll_top_px(double value){
@@ -146,32 +160,397 @@ double ContentBox::calculate_overflowing(double child_pos, double child_size, do
     return 0;
 }
 
+void ContentBox::set_smooth_scrolling(bool value){
+    smooth_scrolling = value;
+    if(!smooth_scrolling){
+        stop_scroll_animation();
+    }
+}
+
+bool ContentBox::get_smooth_scrolling(){
+    return smooth_scrolling;
+}
+
+void ContentBox::set_scroll_friction(double value){
+    scroll_friction = value > 0.01 ? value : 0.01;
+}
+
+double ContentBox::get_scroll_friction(){
+    return scroll_friction;
+}
+
+void ContentBox::add_scroll_velocity(Vector2 velocity){
+    scroll_velocity += velocity;
+    set_process(true);
+}
+
+void ContentBox::stop_scroll_animation(){
+    scroll_velocity = Vector2(0, 0);
+    set_process(false);
+}
+
+bool ContentBox::is_scroll_animating(){
+    return is_processing();
+}
+
+void ContentBox::_process(double delta){
+    // Below half a pixel per second nothing visibly moves anymore.
+    if(scroll_velocity.length_squared() < 0.25){
+        stop_scroll_animation();
+        return;
+    }
+
+    double step_x = scroll_velocity.x * delta;
+    double step_y = scroll_velocity.y * delta;
+    // Overscroll is clamped, velocity of an axis that hit a limit is dropped.
+    bool clamped_y = std::clamp(scroll_top_px + step_y, -max_scroll_top_px, min_scroll_top_px) != scroll_top_px + step_y;
+    bool clamped_x = std::clamp(scroll_left_px + step_x, -max_scroll_left_px, min_scroll_left_px) != scroll_left_px + step_x;
+    apply_scrolling(step_x, step_y);
+
+    if(clamped_y) scroll_velocity.y = 0;
+    if(clamped_x) scroll_velocity.x = 0;
+
+    scroll_velocity *= exp(-scroll_friction * delta);
+}
+
 void ContentBox::_gui_input(const Ref<InputEvent> &p_gui_input){
-    if(overflowing_behaviour == Harmonia::OverflowBehaviour::SCROLL && (is_overflowed_x || is_overflowed_y)){
-        if(auto* mouse_event = Object::cast_to<InputEventMouseButton>(*p_gui_input)){
-            if(mouse_event->is_pressed()){
-                if(mouse_event->get_button_index() == MouseButton::MOUSE_BUTTON_WHEEL_UP){
-                    bool y_priority = calculate_y_priority();
-                    if(y_priority){
-                        apply_scrolling(0, scroll_step_top_px);
-                    }else{
-                        apply_scrolling(scroll_step_left_px, 0);            
-                    }   
-                }else if(mouse_event->get_button_index() == MouseButton::MOUSE_BUTTON_WHEEL_DOWN){
-                    bool y_priority = calculate_y_priority();
-                    if(y_priority){
-                        apply_scrolling(0, -scroll_step_top_px);
-                    }else{
-                        apply_scrolling(-scroll_step_left_px, 0);
-                    }
-                }
+    // Steps are in scroll steps of the box that ends up scrolling.
+    Vector2 step;
+    bool vertical_wheel {false};
+    if(auto* mouse_event = Object::cast_to<InputEventMouseButton>(*p_gui_input)){
+        if(mouse_event->is_pressed()){
+            // Factor is the wheel delta of high resolution wheels, 0 when not supported.
+            double factor = mouse_event->get_factor() > 0 ? mouse_event->get_factor() : 1;
+            if(mouse_event->get_button_index() == MouseButton::MOUSE_BUTTON_WHEEL_UP){
+                step = Vector2(0, factor);
+                vertical_wheel = true;
+            }else if(mouse_event->get_button_index() == MouseButton::MOUSE_BUTTON_WHEEL_DOWN){
+                step = Vector2(0, -factor);
+                vertical_wheel = true;
+            }else if(mouse_event->get_button_index() == MouseButton::MOUSE_BUTTON_WHEEL_LEFT){
+                step = Vector2(factor, 0);
+            }else if(mouse_event->get_button_index() == MouseButton::MOUSE_BUTTON_WHEEL_RIGHT){
+                step = Vector2(-factor, 0);
             }
         }
+    }else if(auto* pan_event = Object::cast_to<InputEventPanGesture>(*p_gui_input)){
+        step = -pan_event->get_delta();
+    }
+
+    if(step.x == 0 && step.y == 0) return;
+
+    // Inside of a ContainerBox the root spatial index picks the scrolled box once, nested boxes don't test the event each.
+    ContentBox* target = this;
+    bool y_priority {true};
+    ContainerBox* container = standalone ? nullptr : Object::cast_to<ContainerBox>(get_parent());
+    if(container){
+        ContainerBox* root = container->get_root_container();
+        SpatialIndex::Hit hit = root->pick_hit(get_global_mouse_position());
+        ContainerBox* scrollable = root->get_spatial_container(hit.scrollable_id);
+        target = scrollable ? scrollable->content_box : nullptr;
+        if(target == nullptr) return; // Nothing scrollable under the pointer, the event keeps propagating.
+        y_priority = target->is_overflowed_y && hit.region != SpatialIndex::REGION_HORIZONTAL_SCROLLBAR;
+    }else{
+        if(overflowing_behaviour != Harmonia::OverflowBehaviour::SCROLL || (!is_overflowed_x && !is_overflowed_y)) return;
+        if(vertical_wheel) y_priority = calculate_y_priority();
+    }
+
+    if(vertical_wheel && !y_priority){
+        step = Vector2(step.y, 0);
+    }
+    step = Vector2(step.x * target->scroll_step_left_px, step.y * target->scroll_step_top_px);
+
+    if(target->smooth_scrolling){
+        // Velocity decaying by the friction travels velocity / friction in total, so each step scrolls by about its size.
+        target->add_scroll_velocity(step * target->scroll_friction);
+    }else{
+        target->apply_scrolling(step.x, step.y);
     }
+    accept_event();
+}
+
+void ContentBox::set_virtualized(bool value){
+    if(virtualized == value) return;
+    virtualized = value;
+    if(!virtualized){
+        clear_items();
+    }
+    item_sizes_dirty = true;
+    items_rebind = true;
+    queue_virtual_update();
+}
+
+bool ContentBox::get_virtualized(){
+    return virtualized;
+}
+
+void ContentBox::set_item_count(int count){
+    item_count = count > 0 ? count : 0;
+    refresh_items();
+}
+
+int ContentBox::get_item_count(){
+    return item_count;
+}
+
+void ContentBox::set_item_scene(const Ref<PackedScene>& scene){
+    item_scene = scene;
+    clear_items();
+    items_rebind = true;
+    queue_virtual_update();
+}
+
+Ref<PackedScene> ContentBox::get_item_scene(){
+    return item_scene;
+}
+
+void ContentBox::set_item_binder(const Callable& binder){
+    item_binder = binder;
+    items_rebind = true;
+    queue_virtual_update();
+}
+
+Callable ContentBox::get_item_binder(){
+    return item_binder;
+}
+
+void ContentBox::set_item_size_provider(const Callable& provider){
+    item_size_provider = provider;
+    item_sizes_dirty = true;
+    queue_virtual_update();
+}
+
+Callable ContentBox::get_item_size_provider(){
+    return item_size_provider;
+}
+
+void ContentBox::set_estimated_item_size(double size){
+    estimated_item_size = size > 0 ? size : 0;
+    item_sizes_dirty = true;
+    queue_virtual_update();
+}
+
+double ContentBox::get_estimated_item_size(){
+    return estimated_item_size;
+}
+
+void ContentBox::set_overscan_px(double value){
+    overscan_px = value > 0 ? value : 0;
+    queue_virtual_update();
+}
+
+double ContentBox::get_overscan_px(){
+    return overscan_px;
+}
+
+void ContentBox::set_item_size(int index, double size){
+    if(index < 0) return;
+    virtual_list.set_item_size(index, size > 0 ? size : 0);
+    queue_virtual_update();
+}
+
+double ContentBox::get_item_size(int index){
+    if(index < 0) return 0;
+    return virtual_list.get_item_size(index);
+}
+
+void ContentBox::refresh_items(){
+    item_sizes_dirty = true;
+    items_rebind = true;
+    queue_virtual_update();
+}
+
+void ContentBox::queue_virtual_update(){
+    if(!virtualized && active_items.empty()) return;
+
+    if(auto* container = Object::cast_to<ContainerBox>(get_parent())){
+        container->mark_layout_dirty(); // Scroll extents change the container overflow, the container updates the items in its layout.
+        return;
+    }
+
+    if(!virtual_update_queued){
+        virtual_update_queued = true;
+        call_deferred("flush_virtual_update");
+    }
+}
+
+void ContentBox::flush_virtual_update(){
+    virtual_update_queued = false;
+    update_virtual_items();
+}
+
+Control* ContentBox::acquire_item(){
+    if(!item_pool.empty()){
+        Control* item = item_pool.back();
+        item_pool.pop_back();
+        item->set_visible(true);
+        return item;
+    }
+
+    if(item_scene.is_null() || !item_scene->can_instantiate()){
+        UtilityFunctions::print("Virtualized ContentBox has no item scene, cannot create items");
+        return nullptr;
+    }
+
+    Node* node = item_scene->instantiate();
+    auto* item = Object::cast_to<Control>(node);
+    if(item == nullptr){
+        UtilityFunctions::print("Root of the item scene has to be a Control");
+        if(node) memdelete(node);
+        return nullptr;
+    }
+    add_child(item);
+    return item;
+}
+
+void ContentBox::release_item(Control* item){
+    item->set_visible(false);
+    item_pool.push_back(item);
+}
+
+void ContentBox::clear_items(){
+    for (Control* item : active_items)
+    {
+        item->queue_free();
+    }
+    for (Control* item : item_pool)
+    {
+        item->queue_free();
+    }
+    active_items.clear();
+    item_pool.clear();
+    active_first = 0;
+}
+
+void ContentBox::update_virtual_items(){
+    if(!virtualized) return;
+
+    if(item_sizes_dirty){
+        item_sizes_dirty = false;
+        virtual_list.resize(item_count, estimated_item_size);
+        if(item_size_provider.is_valid()){
+            for (int i = 0; i < item_count; i++)
+            {
+                double size = item_size_provider.call(i);
+                virtual_list.set_item_size(i, size > 0 ? size : 0);
+            }
+        }else{
+            virtual_list.fill(estimated_item_size);
+        }
+    }
+
+    Vector2 size = get_size();
+    double total_size = virtual_list.get_total_size();
+    is_overflowed_y = total_size > size.y;
+    overflowing_size_y_px = is_overflowed_y ? total_size - size.y : 0;
+    min_scroll_top_px = 0;
+    max_scroll_top_px = overflowing_size_y_px;
+    if(scroll_top_px < -max_scroll_top_px){
+        set_scroll_top_px(-max_scroll_top_px); // List got shorter
+    }else{
+        set_scroll_top_px(scroll_top_px);
+    }
+    apply_overflowing();
+
+    size_t first {0};
+    size_t last {0};
+    virtual_list.get_range(-scroll_top_px, size.y, overscan_px, first, last);
+
+    // Items visible before and after keep their controls, the rest goes back to the pool.
+    next_active_items.assign(last - first, nullptr);
+    for (size_t i = 0; i < active_items.size(); i++)
+    {
+        size_t index = active_first + i;
+        if(!items_rebind && index >= first && index < last){
+            next_active_items[index - first] = active_items[i];
+        }else{
+            release_item(active_items[i]);
+        }
+    }
+    items_rebind = false;
+
+    for (size_t i = 0; i < next_active_items.size(); i++)
+    {
+        if(next_active_items[i] != nullptr) continue;
+        Control* item = acquire_item();
+        if(item == nullptr) break;
+        next_active_items[i] = item;
+        if(item_binder.is_valid()){
+            item_binder.call(item, static_cast<int>(first + i));
+        }
+    }
+
+    // Drops the tail when items could not be created
+    size_t created = 0;
+    while(created < next_active_items.size() && next_active_items[created] != nullptr) created++;
+    for (size_t i = created; i < next_active_items.size(); i++)
+    {
+        if(next_active_items[i]) release_item(next_active_items[i]);
+    }
+    next_active_items.resize(created);
+
+    active_items.swap(next_active_items);
+    active_first = first;
+
+    for (size_t i = 0; i < active_items.size(); i++)
+    {
+        size_t index = active_first + i;
+        active_items[i]->set_position(Vector2(0, virtual_list.get_item_offset(index)));
+        active_items[i]->set_size(Vector2(size.x, virtual_list.get_item_size(index)));
+    }
+}
+
+TypedArray<Control> ContentBox::get_active_items(){
+    TypedArray<Control> items;
+    for (Control* item : active_items)
+    {
+        items.push_back(item);
+    }
+    return items;
+}
+
+int ContentBox::get_first_active_index(){
+    return static_cast<int>(active_first);
 }
 
 void ContentBox::_bind_methods(){
-    
+    ClassDB::bind_method(D_METHOD("set_smooth_scrolling", "value"), &ContentBox::set_smooth_scrolling);
+    ClassDB::bind_method(D_METHOD("get_smooth_scrolling"), &ContentBox::get_smooth_scrolling);
+    ClassDB::bind_method(D_METHOD("set_scroll_friction", "value"), &ContentBox::set_scroll_friction);
+    ClassDB::bind_method(D_METHOD("get_scroll_friction"), &ContentBox::get_scroll_friction);
+    ClassDB::bind_method(D_METHOD("add_scroll_velocity", "velocity"), &ContentBox::add_scroll_velocity);
+    ClassDB::bind_method(D_METHOD("stop_scroll_animation"), &ContentBox::stop_scroll_animation);
+    ClassDB::bind_method(D_METHOD("is_scroll_animating"), &ContentBox::is_scroll_animating);
+
+    ClassDB::bind_method(D_METHOD("set_virtualized", "value"), &ContentBox::set_virtualized);
+    ClassDB::bind_method(D_METHOD("get_virtualized"), &ContentBox::get_virtualized);
+    ClassDB::bind_method(D_METHOD("set_item_count", "count"), &ContentBox::set_item_count);
+    ClassDB::bind_method(D_METHOD("get_item_count"), &ContentBox::get_item_count);
+    ClassDB::bind_method(D_METHOD("set_item_scene", "scene"), &ContentBox::set_item_scene);
+    ClassDB::bind_method(D_METHOD("get_item_scene"), &ContentBox::get_item_scene);
+    ClassDB::bind_method(D_METHOD("set_item_binder", "binder"), &ContentBox::set_item_binder);
+    ClassDB::bind_method(D_METHOD("get_item_binder"), &ContentBox::get_item_binder);
+    ClassDB::bind_method(D_METHOD("set_item_size_provider", "provider"), &ContentBox::set_item_size_provider);
+    ClassDB::bind_method(D_METHOD("get_item_size_provider"), &ContentBox::get_item_size_provider);
+    ClassDB::bind_method(D_METHOD("set_estimated_item_size", "size"), &ContentBox::set_estimated_item_size);
+    ClassDB::bind_method(D_METHOD("get_estimated_item_size"), &ContentBox::get_estimated_item_size);
+    ClassDB::bind_method(D_METHOD("set_overscan_px", "value"), &ContentBox::set_overscan_px);
+    ClassDB::bind_method(D_METHOD("get_overscan_px"), &ContentBox::get_overscan_px);
+    ClassDB::bind_method(D_METHOD("set_item_size", "index", "size"), &ContentBox::set_item_size);
+    ClassDB::bind_method(D_METHOD("get_item_size", "index"), &ContentBox::get_item_size);
+    ClassDB::bind_method(D_METHOD("refresh_items"), &ContentBox::refresh_items);
+    ClassDB::bind_method(D_METHOD("update_virtual_items"), &ContentBox::update_virtual_items);
+    ClassDB::bind_method(D_METHOD("flush_virtual_update"), &ContentBox::flush_virtual_update);
+    ClassDB::bind_method(D_METHOD("get_active_items"), &ContentBox::get_active_items);
+    ClassDB::bind_method(D_METHOD("get_first_active_index"), &ContentBox::get_first_active_index);
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "smooth_scrolling", PROPERTY_HINT_NONE, "smooth_scrolling", PROPERTY_USAGE_DEFAULT), "set_smooth_scrolling", "get_smooth_scrolling");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "scroll_friction", PROPERTY_HINT_RANGE, "0.01,100,0.01,or_greater", PROPERTY_USAGE_DEFAULT), "set_scroll_friction", "get_scroll_friction");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "virtualized", PROPERTY_HINT_NONE, "virtualized", PROPERTY_USAGE_DEFAULT), "set_virtualized", "get_virtualized");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "item_count", PROPERTY_HINT_NONE, "item_count", PROPERTY_USAGE_DEFAULT), "set_item_count", "get_item_count");
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "item_scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene", PROPERTY_USAGE_DEFAULT), "set_item_scene", "get_item_scene");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "estimated_item_size", PROPERTY_HINT_NONE, "estimated_item_size", PROPERTY_USAGE_DEFAULT), "set_estimated_item_size", "get_estimated_item_size");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "overscan_px", PROPERTY_HINT_NONE, "overscan_px", PROPERTY_USAGE_DEFAULT), "set_overscan_px", "get_overscan_px");
 }
 bool ContentBox::_set(const StringName &p_name, const Variant &p_value){
     return false;
@@ -184,5 +563,13 @@ void ContentBox::_get_property_list(List<PropertyInfo> *p_list) const {
 }
 
 void ContentBox::_notification(int p_what){
-    
+    if(p_what == NOTIFICATION_READY){
+        if(standalone) scroll_origin = get_position();
+        if(scroll_velocity == Vector2(0, 0)) set_process(false); // Processing runs only while animating.
+    }else if(p_what == NOTIFICATION_DRAW){
+        // Control's draw already reset the rect to (0, 0, size) and the clip to clip_contents (off).
+        apply_scroll_clip();
+    }else if(p_what == NOTIFICATION_RESIZED && virtualized && standalone){
+        update_virtual_items();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include "core/layout/layout_node.h"
+
+void LayoutNode::add_child(LayoutNode* child){
+    child->parent = this;
+    children.push_back(child);
+}
+
+void LayoutNode::clear_children(){
+    children.clear();
+}
@@ -0,0 +1,722 @@
+#include "core/layout/layout_solver.h"
+#include "commons/unit_conversion.h"
+#include <cmath>
+
+namespace {
+
+template <UnitAxis Axis>
+inline double resolve_length(const LayoutNode::Length& length, const UnitContext& context){
+    return UnitConversion::convert_to<UnitConversion::PIXEL, Axis>(length.unit_type, length.length, context);
+}
+
+}
+
+double LayoutSolver::to_pixels(const LayoutNode::Length& length, double parent_size, double viewport_width, double viewport_height){
+    UnitContext context;
+    context.parent_width = parent_size;
+    context.parent_height = parent_size;
+    context.viewport_width = viewport_width;
+    context.viewport_height = viewport_height;
+    return resolve_length<UnitAxis::WIDTH>(length, context);
+}
+
+void LayoutSolver::resolve_geometry(LayoutNode& node, double parent_width, double parent_height, double viewport_width, double viewport_height){
+    UnitContext context;
+    context.parent_width = parent_width;
+    context.parent_height = parent_height;
+    context.viewport_width = viewport_width;
+    context.viewport_height = viewport_height;
+
+    LayoutNode::Geometry& geometry = node.geometry;
+    geometry.width = resolve_length<UnitAxis::WIDTH>(node.width, context);
+    geometry.height = resolve_length<UnitAxis::HEIGHT>(node.height, context);
+    geometry.padding_up = resolve_length<UnitAxis::HEIGHT>(node.padding_up, context);
+    geometry.padding_right = resolve_length<UnitAxis::WIDTH>(node.padding_right, context);
+    geometry.padding_down = resolve_length<UnitAxis::HEIGHT>(node.padding_down, context);
+    geometry.padding_left = resolve_length<UnitAxis::WIDTH>(node.padding_left, context);
+    geometry.margin_up = resolve_length<UnitAxis::HEIGHT>(node.margin_up, context);
+    geometry.margin_right = resolve_length<UnitAxis::WIDTH>(node.margin_right, context);
+    geometry.margin_down = resolve_length<UnitAxis::HEIGHT>(node.margin_down, context);
+    geometry.margin_left = resolve_length<UnitAxis::WIDTH>(node.margin_left, context);
+    geometry.pos_x = resolve_length<UnitAxis::WIDTH>(node.pos_x, context);
+    geometry.pos_y = resolve_length<UnitAxis::HEIGHT>(node.pos_y, context);
+
+    node.resolved_parent_width = parent_width;
+    node.resolved_parent_height = parent_height;
+    node.resolved_viewport_width = viewport_width;
+    node.resolved_viewport_height = viewport_height;
+    node.geometry_dirty = false;
+}
+
+bool LayoutSolver::update_geometry(LayoutNode& node, double parent_width, double parent_height, double viewport_width, double viewport_height){
+    if(!node.geometry_dirty
+        && node.resolved_parent_width == parent_width
+        && node.resolved_parent_height == parent_height
+        && node.resolved_viewport_width == viewport_width
+        && node.resolved_viewport_height == viewport_height){
+        return false;
+    }
+
+    resolve_geometry(node, parent_width, parent_height, viewport_width, viewport_height);
+    return true;
+}
+
+double LayoutSolver::calculate_overflow(double container, double check_size, double current_overflow){
+    if(check_size > container){
+        double overflow = check_size - container;
+        if(overflow > current_overflow){
+            return overflow;
+        }
+    }
+
+    return current_overflow;
+}
+
+void LayoutSolver::update_overflows(LayoutNode& node){
+    const LayoutNode::Geometry& geometry = node.geometry;
+    double overflow_x {0};
+    double overflow_y {0};
+    double negative_overflow_x {0};
+    double negative_overflow_y {0};
+    double sum_child_sizes_x {0};
+    double sum_child_sizes_y {geometry.padding_up};
+
+    for (LayoutNode* child : node.children)
+    {
+        if(child->kind != LayoutNode::CONTAINER) continue; // Controls are not measured (UNIMPLEMENTED)
+        if(child->hidden) continue;
+
+        const LayoutNode::Geometry& child_geometry = child->geometry;
+        double m_up = child_geometry.margin_up;
+        double m_left = child_geometry.margin_left;
+        double sum_x = child_geometry.width + m_left + child_geometry.margin_right + child_geometry.padding_left + child_geometry.padding_right;
+        double sum_y = child_geometry.height + m_up + child_geometry.margin_down + child_geometry.padding_up + child_geometry.padding_down;
+        double overflow_check_x {0};
+        double overflow_check_y {0};
+        double negative_overflow_check_x {0};
+        double negative_overflow_check_y {0};
+
+        if(m_left < 0){
+            negative_overflow_check_x = m_left;
+        }
+        if(m_up < 0){
+            negative_overflow_check_y = m_up;
+        }
+
+        if(child->position_type == LayoutNode::STATIC){
+            overflow_check_x += sum_x;
+            sum_child_sizes_y += sum_y;
+        }else if(child->position_type == LayoutNode::ABSOLUTE || child->position_type == LayoutNode::RELATIVE){
+            double pos_x = child_geometry.pos_x;
+            double pos_y = child_geometry.pos_y;
+            overflow_check_x += pos_x + sum_x;
+            overflow_check_y += pos_y + sum_y;
+            if(child->position_type == LayoutNode::RELATIVE){
+                sum_child_sizes_y += sum_y;
+            }
+            if(m_left + pos_x < 0){
+                negative_overflow_check_x = (m_left + pos_x);
+            }
+            if(m_up + pos_y < 0){
+                negative_overflow_check_y = (m_up + pos_y);
+            }
+        }
+        overflow_x = calculate_overflow(geometry.width, overflow_check_x, overflow_x);
+        overflow_y = calculate_overflow(geometry.height, overflow_check_y, overflow_y);
+
+        if(negative_overflow_check_x < negative_overflow_x) negative_overflow_x = negative_overflow_check_x;
+        if(negative_overflow_check_y < negative_overflow_y) negative_overflow_y = negative_overflow_check_y;
+    }
+
+    overflow_x = calculate_overflow(geometry.width, sum_child_sizes_x, overflow_x);
+    overflow_y = calculate_overflow(geometry.height, sum_child_sizes_y, overflow_y);
+    overflow_x += std::fabs(negative_overflow_x);
+    overflow_y += std::fabs(negative_overflow_y);
+
+    node.negative_overflow_x = negative_overflow_x;
+    node.negative_overflow_y = negative_overflow_y;
+    node.overflow_x = overflow_x;
+    node.overflow_y = overflow_y;
+    node.is_overflowed_x = overflow_x != 0;
+    node.is_overflowed_y = overflow_y != 0;
+
+    if(node.is_overflowed_x || node.is_overflowed_y){
+        node.content_offset_x = std::fabs(negative_overflow_x);
+        node.content_offset_y = std::fabs(negative_overflow_y);
+    }else{
+        node.content_offset_x = 0;
+        node.content_offset_y = 0;
+    }
+}
+
+void LayoutSolver::update_self_position(LayoutNode& node){
+    const LayoutNode::Geometry& geometry = node.geometry;
+    node.position_x = geometry.margin_left;
+    node.position_y = geometry.margin_up;
+
+    if(node.position_type == LayoutNode::ABSOLUTE || node.position_type == LayoutNode::RELATIVE){
+        node.position_x += geometry.pos_x;
+        node.position_y += geometry.pos_y;
+    }
+}
+
+void LayoutSolver::update_children_position(LayoutNode& node){
+    const LayoutNode::Geometry& geometry = node.geometry;
+    double position_x {0};
+    double position_y {geometry.padding_up};
+
+    if(node.scroll_content){
+        position_x = node.content_offset_x;
+        position_y = node.content_offset_y;
+    }
+
+    for (LayoutNode* child : node.children)
+    {
+        if(child->kind == LayoutNode::CONTROL){
+            if(child->anchored){
+                child->position_x = position_x;
+            }else{
+                // When layout mode is position (this is where anchors are set to 0)
+                child->position_x = position_x + geometry.padding_left;
+            }
+            child->position_y = position_y;
+            position_y += child->geometry.height;
+            continue;
+        }
+
+        if(child->hidden) continue;
+
+        const LayoutNode::Geometry& child_geometry = child->geometry;
+        double m_up = child_geometry.margin_up;
+        double m_left = child_geometry.margin_left;
+        double advance_y = child_geometry.height + child_geometry.margin_down + child_geometry.padding_down + child_geometry.padding_up;
+
+        if(child->position_type == LayoutNode::STATIC){
+            position_y += m_up;
+            child->position_x = position_x + m_left;
+            child->position_y = position_y;
+            position_y += advance_y;
+        }else if(child->position_type == LayoutNode::ABSOLUTE){
+            child->position_x = child_geometry.pos_x + m_left;
+            child->position_y = child_geometry.pos_y + m_up;
+        }else if(child->position_type == LayoutNode::RELATIVE){
+            position_y += m_up;
+            child->position_x = position_x + child_geometry.pos_x + m_left;
+            child->position_y = position_y + child_geometry.pos_y;
+            position_y += advance_y;
+        }
+    }
+}
+
+namespace {
+
+/// Flex item sizes are border box sizes (length with paddings), margins are kept separately.
+struct FlexItem {
+    LayoutNode* node;
+    double main_size;
+    double cross_size;
+    double padding_main;
+    double padding_cross;
+    double margin_main_start;
+    double margin_main_end;
+    double margin_cross_start;
+    double margin_cross_end;
+    double grow;
+    double shrink;
+    bool stretch;
+    double main_position;
+    double cross_position;
+};
+
+/// Cells of a grid container, outer sizes include paddings and margins.
+struct GridCell {
+    LayoutNode* node;
+    double outer_width;
+    double outer_height;
+    bool stretch_width;
+    bool stretch_height;
+};
+
+/// Same content origin as block layout, children positions are offset by it after the overflow is measured.
+inline void get_content_origin(const LayoutNode& node, double& origin_x, double& origin_y){
+    if(node.scroll_content){
+        origin_x = node.content_offset_x;
+        origin_y = node.content_offset_y;
+    }else{
+        origin_x = 0;
+        origin_y = node.geometry.padding_up;
+    }
+}
+
+/// Resolves fixed tracks and counts fractions, auto (NOT_SET) tracks start at 0 and get fitted to their cells.
+template <UnitAxis Axis>
+inline double size_tracks(const std::vector<LayoutNode::Length>& tracks, std::vector<double>& sizes, const UnitContext& context){
+    double total_fraction {0};
+    for (size_t i = 0; i < tracks.size(); i++)
+    {
+        const LayoutNode::Length& track = tracks[i];
+        if(track.unit_type == LayoutNode::FRACTION){
+            total_fraction += track.length;
+            sizes[i] = 0;
+        }else{
+            sizes[i] = resolve_length<Axis>(track, context);
+        }
+    }
+    return total_fraction;
+}
+
+/// Splits the space left after fixed and auto tracks (and gaps) between fraction tracks, then turns sizes into offsets.
+inline void distribute_tracks(const std::vector<LayoutNode::Length>& tracks, std::vector<double>& sizes, std::vector<double>& offsets, double total_fraction, double available, double gap){
+    const size_t count = sizes.size();
+    double used = count > 0 ? gap * (count - 1) : 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        used += sizes[i];
+    }
+
+    double free = available - used;
+    if(free > 0 && total_fraction > 0){
+        for (size_t i = 0; i < tracks.size(); i++)
+        {
+            if(tracks[i].unit_type == LayoutNode::FRACTION){
+                sizes[i] = free * tracks[i].length / total_fraction;
+            }
+        }
+    }
+
+    double offset {0};
+    for (size_t i = 0; i < count; i++)
+    {
+        offsets[i] = offset;
+        offset += sizes[i] + gap;
+    }
+}
+
+inline double get_outer_main(const FlexItem& item){
+    return item.margin_main_start + item.main_size + item.margin_main_end;
+}
+
+inline double get_outer_cross(const FlexItem& item){
+    return item.margin_cross_start + item.cross_size + item.margin_cross_end;
+}
+
+}
+
+void LayoutSolver::update_overflows_from_extents(LayoutNode& node){
+    const LayoutNode::Geometry& geometry = node.geometry;
+    double max_x {0};
+    double max_y {0};
+    double negative_overflow_x {0};
+    double negative_overflow_y {0};
+
+    for (LayoutNode* child : node.children)
+    {
+        if(child->kind != LayoutNode::CONTAINER) continue; // Controls are not measured (UNIMPLEMENTED)
+        if(child->hidden) continue;
+
+        const LayoutNode::Geometry& child_geometry = child->geometry;
+        double left = child->position_x - child_geometry.margin_left;
+        double top = child->position_y - child_geometry.margin_up;
+        double right = child->position_x + child_geometry.width + child_geometry.padding_left + child_geometry.padding_right + child_geometry.margin_right;
+        double bottom = child->position_y + child_geometry.height + child_geometry.padding_up + child_geometry.padding_down + child_geometry.margin_down;
+
+        if(right > max_x) max_x = right;
+        if(bottom > max_y) max_y = bottom;
+        if(left < negative_overflow_x) negative_overflow_x = left;
+        if(top < negative_overflow_y) negative_overflow_y = top;
+    }
+
+    // Distributed sizes do not always sum back exactly, rounding leftovers are not an overflow.
+    constexpr double tolerance = 1e-6;
+    if(max_x - geometry.width < tolerance) max_x = geometry.width;
+    if(max_y - geometry.height < tolerance) max_y = geometry.height;
+    if(negative_overflow_x > -tolerance) negative_overflow_x = 0;
+    if(negative_overflow_y > -tolerance) negative_overflow_y = 0;
+
+    double overflow_x = calculate_overflow(geometry.width, max_x, 0) + std::fabs(negative_overflow_x);
+    double overflow_y = calculate_overflow(geometry.height, max_y, 0) + std::fabs(negative_overflow_y);
+
+    node.negative_overflow_x = negative_overflow_x;
+    node.negative_overflow_y = negative_overflow_y;
+    node.overflow_x = overflow_x;
+    node.overflow_y = overflow_y;
+    node.is_overflowed_x = overflow_x != 0;
+    node.is_overflowed_y = overflow_y != 0;
+
+    if(node.is_overflowed_x || node.is_overflowed_y){
+        node.content_offset_x = std::fabs(negative_overflow_x);
+        node.content_offset_y = std::fabs(negative_overflow_y);
+    }else{
+        node.content_offset_x = 0;
+        node.content_offset_y = 0;
+    }
+}
+
+void LayoutSolver::update_flex(LayoutNode& node, double viewport_width, double viewport_height){
+    // Reused between passes, only grows.
+    static thread_local std::vector<FlexItem> items;
+    static thread_local std::vector<size_t> line_ends;
+    items.clear();
+    line_ends.clear();
+
+    const LayoutNode::Geometry& geometry = node.geometry;
+    const bool row = node.flex_direction == LayoutNode::FLEX_ROW || node.flex_direction == LayoutNode::FLEX_ROW_REVERSE;
+    const bool reverse = node.flex_direction == LayoutNode::FLEX_ROW_REVERSE || node.flex_direction == LayoutNode::FLEX_COLUMN_REVERSE;
+    const bool wrap = node.flex_wrap == LayoutNode::FLEX_WRAP;
+
+    // Items are sized against this container, same as their own geometry.
+    UnitContext context;
+    context.parent_width = geometry.width;
+    context.parent_height = geometry.height;
+    context.viewport_width = viewport_width;
+    context.viewport_height = viewport_height;
+
+    const double inner_main = row ? geometry.width : geometry.height;
+    const double inner_cross = row ? geometry.height : geometry.width;
+    const double column_gap = resolve_length<UnitAxis::WIDTH>(node.column_gap, context);
+    const double row_gap = resolve_length<UnitAxis::HEIGHT>(node.row_gap, context);
+    const double gap_main = row ? column_gap : row_gap;
+    const double gap_cross = row ? row_gap : column_gap;
+
+    for (LayoutNode* child : node.children)
+    {
+        if(child->hidden) continue;
+
+        const LayoutNode::Geometry& child_geometry = child->geometry;
+        if(child->kind == LayoutNode::CONTAINER && child->position_type == LayoutNode::ABSOLUTE){
+            // Out of flow, positioned to the parent same as in block layout.
+            child->position_x = child_geometry.pos_x + child_geometry.margin_left;
+            child->position_y = child_geometry.pos_y + child_geometry.margin_up;
+            continue;
+        }
+
+        // Sizes come from the lengths rather than the geometry, which might hold the flexed size of the previous pass.
+        const LayoutNode::Length& main_length = child->flex_basis.unit_type != LayoutNode::NOT_SET ? child->flex_basis : (row ? child->width : child->height);
+        const LayoutNode::Length& cross_length = row ? child->height : child->width;
+        double main_length_px = row
+            ? resolve_length<UnitAxis::WIDTH>(main_length, context)
+            : resolve_length<UnitAxis::HEIGHT>(main_length, context);
+        double cross_length_px = row
+            ? resolve_length<UnitAxis::HEIGHT>(cross_length, context)
+            : resolve_length<UnitAxis::WIDTH>(cross_length, context);
+
+        FlexItem item;
+        item.node = child;
+        item.padding_main = row ? child_geometry.padding_left + child_geometry.padding_right : child_geometry.padding_up + child_geometry.padding_down;
+        item.padding_cross = row ? child_geometry.padding_up + child_geometry.padding_down : child_geometry.padding_left + child_geometry.padding_right;
+        item.main_size = main_length_px + item.padding_main;
+        item.cross_size = cross_length_px + item.padding_cross;
+        // Margins in flow order, reversed directions flow from the end.
+        double margin_start = row ? child_geometry.margin_left : child_geometry.margin_up;
+        double margin_end = row ? child_geometry.margin_right : child_geometry.margin_down;
+        item.margin_main_start = reverse ? margin_end : margin_start;
+        item.margin_main_end = reverse ? margin_start : margin_end;
+        item.margin_cross_start = row ? child_geometry.margin_up : child_geometry.margin_left;
+        item.margin_cross_end = row ? child_geometry.margin_down : child_geometry.margin_right;
+        bool is_container = child->kind == LayoutNode::CONTAINER;
+        item.grow = is_container ? child->flex_grow : 0;
+        item.shrink = is_container ? child->flex_shrink : 0;
+        item.stretch = is_container && node.align_items == LayoutNode::ALIGN_STRETCH && cross_length.unit_type == LayoutNode::NOT_SET;
+        item.main_position = 0;
+        item.cross_position = 0;
+        items.push_back(item);
+    }
+
+    // Line breaking
+    double line_main {0};
+    size_t line_count {0};
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        double outer_main = get_outer_main(items[i]);
+        if(wrap && line_count > 0 && line_main + gap_main + outer_main > inner_main){
+            line_ends.push_back(i);
+            line_main = 0;
+            line_count = 0;
+        }
+        line_main += (line_count > 0 ? gap_main : 0) + outer_main;
+        line_count++;
+    }
+    if(!items.empty()) line_ends.push_back(items.size());
+
+    double cross_cursor {0};
+    size_t line_start {0};
+    for (size_t line_end : line_ends)
+    {
+        const size_t count = line_end - line_start;
+        double used_main = gap_main * (count - 1);
+        double total_grow {0};
+        double total_shrink {0};
+        for (size_t i = line_start; i < line_end; i++)
+        {
+            used_main += get_outer_main(items[i]);
+            total_grow += items[i].grow;
+            total_shrink += items[i].shrink * (items[i].main_size - items[i].padding_main);
+        }
+
+        // Grow and shrink, single pass without re-distributing what got clamped.
+        double free_main = inner_main - used_main;
+        if(free_main > 0 && total_grow > 0){
+            for (size_t i = line_start; i < line_end; i++)
+            {
+                items[i].main_size += free_main * items[i].grow / total_grow;
+            }
+            free_main = 0;
+        }else if(free_main < 0 && total_shrink > 0){
+            used_main = gap_main * (count - 1);
+            for (size_t i = line_start; i < line_end; i++)
+            {
+                FlexItem& item = items[i];
+                item.main_size += free_main * item.shrink * (item.main_size - item.padding_main) / total_shrink;
+                if(item.main_size < item.padding_main) item.main_size = item.padding_main;
+                used_main += get_outer_main(item);
+            }
+            free_main = inner_main - used_main;
+        }
+
+        double line_cross {0};
+        if(!wrap){
+            line_cross = inner_cross;
+        }else{
+            for (size_t i = line_start; i < line_end; i++)
+            {
+                double outer_cross = get_outer_cross(items[i]);
+                if(outer_cross > line_cross) line_cross = outer_cross;
+            }
+        }
+
+        double distributed = free_main > 0 ? free_main : 0;
+        double leading {0};
+        double between {0};
+        switch (node.justify_content)
+        {
+        case LayoutNode::JUSTIFY_END:
+            leading = free_main;
+            break;
+        case LayoutNode::JUSTIFY_CENTER:
+            leading = free_main / 2;
+            break;
+        case LayoutNode::JUSTIFY_SPACE_BETWEEN:
+            between = count > 1 ? distributed / (count - 1) : 0;
+            break;
+        case LayoutNode::JUSTIFY_SPACE_AROUND:
+            between = distributed / count;
+            leading = between / 2;
+            break;
+        case LayoutNode::JUSTIFY_SPACE_EVENLY:
+            between = distributed / (count + 1);
+            leading = between;
+            break;
+        default:
+            break;
+        }
+
+        double main_cursor = leading;
+        for (size_t i = line_start; i < line_end; i++)
+        {
+            FlexItem& item = items[i];
+            double flow_position = main_cursor + item.margin_main_start;
+            item.main_position = reverse ? inner_main - flow_position - item.main_size : flow_position;
+            main_cursor += get_outer_main(item) + gap_main + between;
+
+            double cross_offset {0};
+            if(item.stretch){
+                double stretched = line_cross - item.margin_cross_start - item.margin_cross_end;
+                item.cross_size = stretched > item.padding_cross ? stretched : item.padding_cross;
+            }else if(node.align_items == LayoutNode::ALIGN_END){
+                cross_offset = line_cross - get_outer_cross(item);
+            }else if(node.align_items == LayoutNode::ALIGN_CENTER){
+                cross_offset = (line_cross - get_outer_cross(item)) / 2;
+            }
+            item.cross_position = cross_cursor + cross_offset + item.margin_cross_start;
+        }
+
+        cross_cursor += line_cross + gap_cross;
+        line_start = line_end;
+    }
+
+    for (FlexItem& item : items)
+    {
+        LayoutNode* child = item.node;
+        child->position_x = row ? item.main_position : item.cross_position;
+        child->position_y = row ? item.cross_position : item.main_position;
+        if(child->kind != LayoutNode::CONTAINER) continue;
+
+        // Flexed sizes replace the resolved ones, children of the item get resolved against them.
+        LayoutNode::Geometry& child_geometry = child->geometry;
+        if(row){
+            child_geometry.width = item.main_size - item.padding_main;
+            child_geometry.height = item.cross_size - item.padding_cross;
+        }else{
+            child_geometry.height = item.main_size - item.padding_main;
+            child_geometry.width = item.cross_size - item.padding_cross;
+        }
+    }
+
+    update_overflows_from_extents(node);
+
+    double origin_x {0};
+    double origin_y {0};
+    get_content_origin(node, origin_x, origin_y);
+    for (FlexItem& item : items)
+    {
+        item.node->position_x += origin_x;
+        item.node->position_y += origin_y;
+    }
+}
+
+void LayoutSolver::update_grid(LayoutNode& node, double viewport_width, double viewport_height){
+    // Reused between passes, only grow.
+    static thread_local std::vector<GridCell> cells;
+    static thread_local std::vector<LayoutNode::Length> columns;
+    static thread_local std::vector<LayoutNode::Length> rows;
+    static thread_local std::vector<double> column_sizes;
+    static thread_local std::vector<double> row_sizes;
+    static thread_local std::vector<double> column_offsets;
+    static thread_local std::vector<double> row_offsets;
+    cells.clear();
+
+    const LayoutNode::Geometry& geometry = node.geometry;
+    UnitContext context;
+    context.parent_width = geometry.width;
+    context.parent_height = geometry.height;
+    context.viewport_width = viewport_width;
+    context.viewport_height = viewport_height;
+
+    for (LayoutNode* child : node.children)
+    {
+        if(child->hidden) continue;
+
+        const LayoutNode::Geometry& child_geometry = child->geometry;
+        if(child->kind == LayoutNode::CONTAINER && child->position_type == LayoutNode::ABSOLUTE){
+            // Out of flow, positioned to the parent same as in block layout.
+            child->position_x = child_geometry.pos_x + child_geometry.margin_left;
+            child->position_y = child_geometry.pos_y + child_geometry.margin_up;
+            continue;
+        }
+
+        // Sizes come from the lengths rather than the geometry, which might hold the stretched size of the previous pass.
+        bool is_container = child->kind == LayoutNode::CONTAINER;
+        GridCell cell;
+        cell.node = child;
+        cell.outer_width = resolve_length<UnitAxis::WIDTH>(child->width, context)
+            + child_geometry.padding_left + child_geometry.padding_right + child_geometry.margin_left + child_geometry.margin_right;
+        cell.outer_height = resolve_length<UnitAxis::HEIGHT>(child->height, context)
+            + child_geometry.padding_up + child_geometry.padding_down + child_geometry.margin_up + child_geometry.margin_down;
+        cell.stretch_width = is_container && child->width.unit_type == LayoutNode::NOT_SET;
+        cell.stretch_height = is_container && child->height.unit_type == LayoutNode::NOT_SET;
+        cells.push_back(cell);
+    }
+
+    // Without defined columns the grid is a single column filling the container.
+    columns.assign(node.grid_columns.begin(), node.grid_columns.end());
+    if(columns.empty()){
+        LayoutNode::Length fill;
+        fill.unit_type = LayoutNode::FRACTION;
+        fill.length = 1;
+        columns.push_back(fill);
+    }
+    const size_t column_count = columns.size();
+    const size_t used_rows = (cells.size() + column_count - 1) / column_count;
+    // Implicit rows are auto rows
+    rows.assign(node.grid_rows.begin(), node.grid_rows.end());
+    if(rows.size() < used_rows) rows.resize(used_rows);
+    const size_t row_count = rows.size();
+
+    column_sizes.resize(column_count);
+    column_offsets.resize(column_count);
+    row_sizes.resize(row_count);
+    row_offsets.resize(row_count);
+    double column_fraction = size_tracks<UnitAxis::WIDTH>(columns, column_sizes, context);
+    double row_fraction = size_tracks<UnitAxis::HEIGHT>(rows, row_sizes, context);
+
+    // Auto tracks fit their largest cell
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        size_t column = i % column_count;
+        size_t row = i / column_count;
+        if(columns[column].unit_type == LayoutNode::NOT_SET && cells[i].outer_width > column_sizes[column]){
+            column_sizes[column] = cells[i].outer_width;
+        }
+        if(rows[row].unit_type == LayoutNode::NOT_SET && cells[i].outer_height > row_sizes[row]){
+            row_sizes[row] = cells[i].outer_height;
+        }
+    }
+
+    const double column_gap = resolve_length<UnitAxis::WIDTH>(node.column_gap, context);
+    const double row_gap = resolve_length<UnitAxis::HEIGHT>(node.row_gap, context);
+    distribute_tracks(columns, column_sizes, column_offsets, column_fraction, geometry.width, column_gap);
+    distribute_tracks(rows, row_sizes, row_offsets, row_fraction, geometry.height, row_gap);
+
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        const GridCell& cell = cells[i];
+        size_t column = i % column_count;
+        size_t row = i / column_count;
+        LayoutNode* child = cell.node;
+        LayoutNode::Geometry& child_geometry = child->geometry;
+        child->position_x = column_offsets[column] + child_geometry.margin_left;
+        child->position_y = row_offsets[row] + child_geometry.margin_up;
+
+        // Stretched sizes replace the resolved ones, children of the cell get resolved against them.
+        if(cell.stretch_width){
+            double width = column_sizes[column] - child_geometry.margin_left - child_geometry.margin_right - child_geometry.padding_left - child_geometry.padding_right;
+            child_geometry.width = width > 0 ? width : 0;
+        }
+        if(cell.stretch_height){
+            double height = row_sizes[row] - child_geometry.margin_up - child_geometry.margin_down - child_geometry.padding_up - child_geometry.padding_down;
+            child_geometry.height = height > 0 ? height : 0;
+        }
+    }
+
+    update_overflows_from_extents(node);
+
+    double origin_x {0};
+    double origin_y {0};
+    get_content_origin(node, origin_x, origin_y);
+    for (const GridCell& cell : cells)
+    {
+        cell.node->position_x += origin_x;
+        cell.node->position_y += origin_y;
+    }
+}
+
+void LayoutSolver::layout(LayoutNode& node, double viewport_width, double viewport_height){
+    if(node.parent == nullptr){
+        update_geometry(node, viewport_width, viewport_height, viewport_width, viewport_height);
+        update_self_position(node);
+    }else{
+        update_geometry(node, node.parent->geometry.width, node.parent->geometry.height, viewport_width, viewport_height);
+    }
+
+    const LayoutNode::Geometry& geometry = node.geometry;
+    node.total_width = geometry.width + geometry.padding_left + geometry.padding_right;
+    node.total_height = geometry.height + geometry.padding_up + geometry.padding_down;
+
+    for (LayoutNode* child : node.children)
+    {
+        update_geometry(*child, geometry.width, geometry.height, viewport_width, viewport_height);
+    }
+
+    if(node.layout_mode == LayoutNode::LAYOUT_FLEX){
+        update_flex(node, viewport_width, viewport_height);
+        return;
+    }
+
+    if(node.layout_mode == LayoutNode::LAYOUT_GRID){
+        update_grid(node, viewport_width, viewport_height);
+        return;
+    }
+
+    update_overflows(node);
+    update_children_position(node);
+}
+
+void LayoutSolver::solve(LayoutNode& root, double viewport_width, double viewport_height){
+    layout(root, viewport_width, viewport_height);
+    for (LayoutNode* child : root.children)
+    {
+        if(child->kind == LayoutNode::CONTAINER){
+            solve(*child, viewport_width, viewport_height);
+        }
+    }
+}
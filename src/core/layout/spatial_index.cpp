@@ -0,0 +1,206 @@
+#include "core/layout/spatial_index.h"
+#include <algorithm>
+
+namespace {
+    /// @brief Entries per leaf, small leaves are tested linearly.
+    constexpr int LEAF_SIZE = 4;
+    /// @brief Median splits keep the hierarchy balanced, so this covers far more entries than a tree can hold.
+    constexpr int MAX_STACK = 64;
+}
+
+bool SpatialIndex::Rect::has_point(double point_x, double point_y) const{
+    return width > 0 && height > 0 &&
+        point_x >= x && point_x < x + width &&
+        point_y >= y && point_y < y + height;
+}
+
+void SpatialIndex::clear(){
+    entries.clear();
+    entry_scopes.clear();
+    ordered.clear();
+    ordered_rects.clear();
+    nodes.clear();
+    scopes.clear();
+    scopes.push_back(Scope());
+}
+
+int SpatialIndex::add_scope(){
+    scopes.push_back(Scope());
+    return (int)scopes.size() - 1;
+}
+
+void SpatialIndex::set_scope_origin(int scope, double x, double y){
+    if(scope < 0 || scope >= (int)scopes.size()) return;
+    scopes[scope].origin_x = x;
+    scopes[scope].origin_y = y;
+}
+
+void SpatialIndex::add_entry(int scope, const Entry& entry){
+    entries.push_back(entry);
+    entry_scopes.push_back(scope);
+}
+
+void SpatialIndex::build(){
+    ordered.resize(entries.size());
+    for (size_t i = 0; i < ordered.size(); i++)
+    {
+        ordered[i] = (int)i;
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [this](int a, int b){
+        return entry_scopes[a] < entry_scopes[b];
+    });
+
+    nodes.clear();
+    nodes.reserve(entries.size() / 2 + 1);
+    for (Scope& scope : scopes)
+    {
+        scope.root = -1;
+    }
+
+    size_t first = 0;
+    while(first < ordered.size()){
+        int scope = entry_scopes[ordered[first]];
+        size_t last = first;
+        while(last < ordered.size() && entry_scopes[ordered[last]] == scope) last++;
+
+        if(scope >= 0 && scope < (int)scopes.size()){
+            scopes[scope].root = (int)nodes.size();
+            nodes.emplace_back();
+            build_node(scopes[scope].root, (int)first, (int)(last - first));
+        }
+        first = last;
+    }
+
+    ordered_rects.resize(ordered.size());
+    for (size_t i = 0; i < ordered.size(); i++)
+    {
+        ordered_rects[i] = entries[ordered[i]].rect;
+    }
+}
+
+void SpatialIndex::build_node(int node, int first, int count){
+    Bounds bounds {entries[ordered[first]].rect.x, entries[ordered[first]].rect.y, entries[ordered[first]].rect.x, entries[ordered[first]].rect.y};
+    Bounds centers {bounds};
+    for (int i = first; i < first + count; i++)
+    {
+        const Rect& rect = entries[ordered[i]].rect;
+        bounds.min_x = std::min(bounds.min_x, rect.x);
+        bounds.min_y = std::min(bounds.min_y, rect.y);
+        bounds.max_x = std::max(bounds.max_x, rect.x + rect.width);
+        bounds.max_y = std::max(bounds.max_y, rect.y + rect.height);
+
+        double center_x = rect.x + rect.width * 0.5;
+        double center_y = rect.y + rect.height * 0.5;
+        centers.min_x = std::min(centers.min_x, center_x);
+        centers.min_y = std::min(centers.min_y, center_y);
+        centers.max_x = std::max(centers.max_x, center_x);
+        centers.max_y = std::max(centers.max_y, center_y);
+    }
+    nodes[node].bounds = bounds;
+    nodes[node].first = first;
+    nodes[node].count = count;
+
+    if(count <= LEAF_SIZE) return;
+
+    // Median split along the longer axis of the centers.
+    bool split_x = centers.max_x - centers.min_x >= centers.max_y - centers.min_y;
+    int half = count / 2;
+    std::nth_element(ordered.begin() + first, ordered.begin() + first + half, ordered.begin() + first + count, [this, split_x](int a, int b){
+        const Rect& rect_a = entries[a].rect;
+        const Rect& rect_b = entries[b].rect;
+        if(split_x) return rect_a.x * 2 + rect_a.width < rect_b.x * 2 + rect_b.width;
+        return rect_a.y * 2 + rect_a.height < rect_b.y * 2 + rect_b.height;
+    });
+
+    int left = (int)nodes.size();
+    nodes.emplace_back();
+    nodes.emplace_back();
+    nodes[node].left = left;
+    build_node(left, first, half);
+    build_node(left + 1, first + half, count - half);
+}
+
+int SpatialIndex::find_deepest(const Scope& scope, double x, double y) const{
+    if(scope.root < 0) return -1;
+
+    int best = -1;
+    int stack[MAX_STACK];
+    int stack_size = 0;
+    stack[stack_size++] = scope.root;
+    while(stack_size > 0){
+        const Node& node = nodes[stack[--stack_size]];
+        if(x < node.bounds.min_x || x >= node.bounds.max_x || y < node.bounds.min_y || y >= node.bounds.max_y) continue;
+
+        if(node.left >= 0 && stack_size + 2 <= MAX_STACK){
+            stack[stack_size++] = node.left;
+            stack[stack_size++] = node.left + 1;
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; i++)
+        {
+            if(!ordered_rects[i].has_point(x, y)) continue;
+            int index = ordered[i];
+            const Entry& entry = entries[index];
+            if(best < 0 || entry.depth > entries[best].depth || (entry.depth == entries[best].depth && index > best)){
+                best = index;
+            }
+        }
+    }
+    return best;
+}
+
+SpatialIndex::Hit SpatialIndex::query(double x, double y) const{
+    Hit hit;
+    // Deepest scrollable container found so far and the point in its scope, for the band above its horizontal scrollbar.
+    const Entry* scrollable = nullptr;
+    double scrollable_x {0};
+    double scrollable_y {0};
+
+    int scope = 0;
+    while(scope >= 0 && scope < (int)scopes.size()){
+        int index = find_deepest(scopes[scope], x, y);
+        if(index < 0) break;
+
+        const Entry& entry = entries[index];
+        hit.id = entry.id;
+        if(entry.scrollable){
+            // Scrollbars are drawn above the content, they win over anything inside of the container.
+            if(entry.vertical_scrollbar.has_point(x, y)){
+                hit.scrollable_id = entry.id;
+                hit.region = REGION_VERTICAL_SCROLLBAR;
+                return hit;
+            }
+            if(entry.horizontal_scrollbar.has_point(x, y)){
+                hit.scrollable_id = entry.id;
+                hit.region = REGION_HORIZONTAL_SCROLLBAR;
+                return hit;
+            }
+            hit.scrollable_id = entry.id;
+            hit.region = REGION_CONTENT;
+            scrollable = &entry;
+            scrollable_x = x;
+            scrollable_y = y;
+        }
+
+        scope = entry.content_scope;
+        if(scope >= 0 && scope < (int)scopes.size()){
+            x -= scopes[scope].origin_x;
+            y -= scopes[scope].origin_y;
+        }
+    }
+
+    if(scrollable && scrollable->horizontal_scrollbar_band > 0){
+        Rect band = scrollable->horizontal_scrollbar;
+        band.y -= scrollable->horizontal_scrollbar_band;
+        band.height += scrollable->horizontal_scrollbar_band;
+        if(band.has_point(scrollable_x, scrollable_y)){
+            hit.region = REGION_HORIZONTAL_SCROLLBAR;
+        }
+    }
+    return hit;
+}
+
+size_t SpatialIndex::size() const{
+    return entries.size();
+}
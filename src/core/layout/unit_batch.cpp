@@ -0,0 +1,246 @@
+#include "core/layout/unit_batch.h"
+#include "core/layout/layout_node.h"
+#include "commons/unit_conversion.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HARMONIA_UNIT_BATCH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define HARMONIA_TARGET_AVX2
+#else
+#define HARMONIA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define HARMONIA_UNIT_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+inline double scalar_to_pixels(int32_t unit, double length, double parent_size, double viewport_width, double viewport_height){
+    UnitContext context;
+    context.parent_width = parent_size;
+    context.viewport_width = viewport_width;
+    context.viewport_height = viewport_height;
+    return UnitConversion::convert_to<UnitConversion::PIXEL, UnitAxis::WIDTH>(unit, length, context);
+}
+
+void kernel_scalar(const int32_t* units, const double* lengths, const double* parent_sizes,
+    double viewport_width, double viewport_height, double* results, size_t start, size_t count){
+    for (size_t i = start; i < count; i++)
+    {
+        results[i] = scalar_to_pixels(units[i], lengths[i], parent_sizes[i], viewport_width, viewport_height);
+    }
+}
+
+#if defined(HARMONIA_UNIT_BATCH_X86)
+void kernel_sse2(const int32_t* units, const double* lengths, const double* parent_sizes,
+    double viewport_width, double viewport_height, double* results, size_t count){
+    const __m128i pixel = _mm_set1_epi32(LayoutNode::PIXEL);
+    const __m128i percentage = _mm_set1_epi32(LayoutNode::PERCENTAGE);
+    const __m128i vw = _mm_set1_epi32(LayoutNode::VIEWPORT_WIDTH);
+    const __m128i vh = _mm_set1_epi32(LayoutNode::VIEWPORT_HEIGHT);
+    const __m128d hundred = _mm_set1_pd(100);
+    const __m128d width = _mm_set1_pd(viewport_width);
+    const __m128d height = _mm_set1_pd(viewport_height);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        // Each 32 bit unit duplicated into a 64 bit lane, so equality masks cover whole doubles.
+        __m128i unit = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(units + i));
+        unit = _mm_unpacklo_epi32(unit, unit);
+        __m128d length = _mm_loadu_pd(lengths + i);
+        __m128d parent_size = _mm_loadu_pd(parent_sizes + i);
+        __m128d viewport_length = _mm_div_pd(length, hundred);
+
+        __m128d result = _mm_and_pd(_mm_castsi128_pd(_mm_cmpeq_epi32(unit, pixel)), length);
+        result = _mm_or_pd(result, _mm_and_pd(_mm_castsi128_pd(_mm_cmpeq_epi32(unit, percentage)), _mm_mul_pd(parent_size, length)));
+        result = _mm_or_pd(result, _mm_and_pd(_mm_castsi128_pd(_mm_cmpeq_epi32(unit, vw)), _mm_mul_pd(viewport_length, width)));
+        result = _mm_or_pd(result, _mm_and_pd(_mm_castsi128_pd(_mm_cmpeq_epi32(unit, vh)), _mm_mul_pd(viewport_length, height)));
+        _mm_storeu_pd(results + i, result);
+    }
+    kernel_scalar(units, lengths, parent_sizes, viewport_width, viewport_height, results, i, count);
+}
+
+HARMONIA_TARGET_AVX2
+void kernel_avx2(const int32_t* units, const double* lengths, const double* parent_sizes,
+    double viewport_width, double viewport_height, double* results, size_t count){
+    const __m256i pixel = _mm256_set1_epi64x(LayoutNode::PIXEL);
+    const __m256i percentage = _mm256_set1_epi64x(LayoutNode::PERCENTAGE);
+    const __m256i vw = _mm256_set1_epi64x(LayoutNode::VIEWPORT_WIDTH);
+    const __m256i vh = _mm256_set1_epi64x(LayoutNode::VIEWPORT_HEIGHT);
+    const __m256d hundred = _mm256_set1_pd(100);
+    const __m256d width = _mm256_set1_pd(viewport_width);
+    const __m256d height = _mm256_set1_pd(viewport_height);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i unit = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(units + i)));
+        __m256d length = _mm256_loadu_pd(lengths + i);
+        __m256d parent_size = _mm256_loadu_pd(parent_sizes + i);
+        __m256d viewport_length = _mm256_div_pd(length, hundred);
+
+        __m256d result = _mm256_and_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(unit, pixel)), length);
+        result = _mm256_or_pd(result, _mm256_and_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(unit, percentage)), _mm256_mul_pd(parent_size, length)));
+        result = _mm256_or_pd(result, _mm256_and_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(unit, vw)), _mm256_mul_pd(viewport_length, width)));
+        result = _mm256_or_pd(result, _mm256_and_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(unit, vh)), _mm256_mul_pd(viewport_length, height)));
+        _mm256_storeu_pd(results + i, result);
+    }
+    kernel_scalar(units, lengths, parent_sizes, viewport_width, viewport_height, results, i, count);
+}
+
+bool cpu_supports_avx2(){
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return os_saves_ymm && (info[1] & (1 << 5));
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#if defined(HARMONIA_UNIT_BATCH_NEON)
+void kernel_neon(const int32_t* units, const double* lengths, const double* parent_sizes,
+    double viewport_width, double viewport_height, double* results, size_t count){
+    const int64x2_t pixel = vdupq_n_s64(LayoutNode::PIXEL);
+    const int64x2_t percentage = vdupq_n_s64(LayoutNode::PERCENTAGE);
+    const int64x2_t vw = vdupq_n_s64(LayoutNode::VIEWPORT_WIDTH);
+    const int64x2_t vh = vdupq_n_s64(LayoutNode::VIEWPORT_HEIGHT);
+    const float64x2_t hundred = vdupq_n_f64(100);
+    const float64x2_t width = vdupq_n_f64(viewport_width);
+    const float64x2_t height = vdupq_n_f64(viewport_height);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        int64x2_t unit = vmovl_s32(vld1_s32(units + i));
+        float64x2_t length = vld1q_f64(lengths + i);
+        float64x2_t parent_size = vld1q_f64(parent_sizes + i);
+        float64x2_t viewport_length = vdivq_f64(length, hundred);
+
+        float64x2_t result = vdupq_n_f64(0);
+        result = vbslq_f64(vceqq_s64(unit, pixel), length, result);
+        result = vbslq_f64(vceqq_s64(unit, percentage), vmulq_f64(parent_size, length), result);
+        result = vbslq_f64(vceqq_s64(unit, vw), vmulq_f64(viewport_length, width), result);
+        result = vbslq_f64(vceqq_s64(unit, vh), vmulq_f64(viewport_length, height), result);
+        vst1q_f64(results + i, result);
+    }
+    kernel_scalar(units, lengths, parent_sizes, viewport_width, viewport_height, results, i, count);
+}
+#endif
+
+UnitBatch::Kernel detect_kernel(){
+#if defined(HARMONIA_UNIT_BATCH_X86)
+    if(cpu_supports_avx2()) return UnitBatch::KERNEL_AVX2;
+    return UnitBatch::KERNEL_SSE2;
+#elif defined(HARMONIA_UNIT_BATCH_NEON)
+    return UnitBatch::KERNEL_NEON;
+#else
+    return UnitBatch::KERNEL_SCALAR;
+#endif
+}
+
+}
+
+UnitBatch::Kernel UnitBatch::get_kernel(){
+    static const Kernel kernel = detect_kernel();
+    return kernel;
+}
+
+bool UnitBatch::is_kernel_supported(Kernel kernel){
+    switch (kernel)
+    {
+    case KERNEL_SCALAR:
+        return true;
+#if defined(HARMONIA_UNIT_BATCH_X86)
+    case KERNEL_SSE2:
+        return true;
+    case KERNEL_AVX2:
+        return get_kernel() == KERNEL_AVX2;
+#endif
+#if defined(HARMONIA_UNIT_BATCH_NEON)
+    case KERNEL_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* UnitBatch::get_kernel_name(Kernel kernel){
+    switch (kernel)
+    {
+    case KERNEL_SSE2:
+        return "sse2";
+    case KERNEL_AVX2:
+        return "avx2";
+    case KERNEL_NEON:
+        return "neon";
+    default:
+        return "scalar";
+    }
+}
+
+void UnitBatch::to_pixels(const int32_t* units, const double* lengths, const double* parent_sizes,
+    double viewport_width, double viewport_height, double* results, size_t count){
+    to_pixels(get_kernel(), units, lengths, parent_sizes, viewport_width, viewport_height, results, count);
+}
+
+void UnitBatch::to_pixels(Kernel kernel, const int32_t* units, const double* lengths, const double* parent_sizes,
+    double viewport_width, double viewport_height, double* results, size_t count){
+    switch (kernel)
+    {
+#if defined(HARMONIA_UNIT_BATCH_X86)
+    case KERNEL_SSE2:
+        kernel_sse2(units, lengths, parent_sizes, viewport_width, viewport_height, results, count);
+        return;
+    case KERNEL_AVX2:
+        kernel_avx2(units, lengths, parent_sizes, viewport_width, viewport_height, results, count);
+        return;
+#endif
+#if defined(HARMONIA_UNIT_BATCH_NEON)
+    case KERNEL_NEON:
+        kernel_neon(units, lengths, parent_sizes, viewport_width, viewport_height, results, count);
+        return;
+#endif
+    default:
+        kernel_scalar(units, lengths, parent_sizes, viewport_width, viewport_height, results, 0, count);
+        return;
+    }
+}
+
+void UnitBatch::clear(){
+    units.clear();
+    lengths.clear();
+    parent_sizes.clear();
+    results.clear();
+}
+
+void UnitBatch::resize(size_t count){
+    units.resize(count);
+    lengths.resize(count);
+    parent_sizes.resize(count);
+}
+
+void UnitBatch::push(int32_t unit, double length, double parent_size){
+    units.push_back(unit);
+    lengths.push_back(length);
+    parent_sizes.push_back(parent_size);
+}
+
+void UnitBatch::convert(double viewport_width, double viewport_height){
+    results.resize(units.size());
+    to_pixels(units.data(), lengths.data(), parent_sizes.data(), viewport_width, viewport_height, results.data(), units.size());
+}
+
+size_t UnitBatch::size() const{
+    return units.size();
+}
@@ -0,0 +1,75 @@
+#include "core/layout/virtual_list.h"
+#include <algorithm>
+
+void VirtualList::resize(size_t count, double size){
+    size_t old_count = sizes.size();
+    sizes.resize(count, size);
+    offsets.resize(count + 1);
+    dirty_from = std::min(dirty_from, std::min(old_count, count));
+}
+
+void VirtualList::fill(double size){
+    std::fill(sizes.begin(), sizes.end(), size);
+    dirty_from = 0;
+}
+
+void VirtualList::set_item_size(size_t index, double size){
+    if(index >= sizes.size() || sizes[index] == size) return;
+    sizes[index] = size;
+    dirty_from = std::min(dirty_from, index);
+}
+
+double VirtualList::get_item_size(size_t index) const{
+    if(index >= sizes.size()) return 0;
+    return sizes[index];
+}
+
+double VirtualList::get_item_offset(size_t index){
+    update_offsets();
+    if(index >= offsets.size()) return offsets.back();
+    return offsets[index];
+}
+
+double VirtualList::get_total_size(){
+    update_offsets();
+    return offsets.back();
+}
+
+size_t VirtualList::size() const{
+    return sizes.size();
+}
+
+void VirtualList::get_range(double view_start, double view_size, double overscan, size_t& first, size_t& last){
+    update_offsets();
+    const size_t count = sizes.size();
+    double start = view_start - overscan;
+    double end = view_start + view_size + overscan;
+
+    if(start >= offsets[count]){
+        first = count;
+        last = count;
+        return;
+    }
+
+    // Last item starting at or before the start of the view, contains the start.
+    auto first_it = std::upper_bound(offsets.begin(), offsets.begin() + count, start);
+    first = first_it == offsets.begin() ? 0 : static_cast<size_t>(first_it - offsets.begin()) - 1;
+    // Items starting before the end of the view.
+    auto last_it = std::lower_bound(offsets.begin() + first, offsets.begin() + count, end);
+    last = static_cast<size_t>(last_it - offsets.begin());
+    if(last < first) last = first;
+}
+
+void VirtualList::update_offsets(){
+    const size_t count = sizes.size();
+    if(dirty_from >= count) return;
+
+    double offset = offsets[dirty_from];
+    for (size_t i = dirty_from; i < count; i++)
+    {
+        offsets[i] = offset;
+        offset += sizes[i];
+    }
+    offsets[count] = offset;
+    dirty_from = count;
+}
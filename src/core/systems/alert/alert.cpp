@@ -1,19 +1,118 @@
 #include "core/systems/alert/alert.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // Names are kept as std::string, Godot strings must not outlive the engine in static storage.
+    std::unordered_map<std::string, int>& get_type_ids(){
+        static std::unordered_map<std::string, int> type_ids;
+        return type_ids;
+    }
+
+    std::vector<std::string>& get_type_names(){
+        static std::vector<std::string> type_names;
+        return type_names;
+    }
+
+    // Alert managers bind from any thread, dispatches use the cached type and don't take it.
+    std::mutex& get_types_mutex(){
+        static std::mutex types_mutex;
+        return types_mutex;
+    }
+}
 
 void Alert::_bind_methods()
 {
     ClassDB::bind_method(D_METHOD("get_alert_name"), &Alert::get_alert_name);
     ClassDB::bind_method(D_METHOD("set_alert_name", "alert_name"), &Alert::set_alert_name);
+    ClassDB::bind_method(D_METHOD("get_alert_type"), &Alert::get_alert_type);
+    ClassDB::bind_method(D_METHOD("set_sender", "sender"), &Alert::set_sender);
+    ClassDB::bind_method(D_METHOD("get_sender"), &Alert::get_sender);
+    ClassDB::bind_method(D_METHOD("get_current_target"), &Alert::get_current_target);
+    ClassDB::bind_method(D_METHOD("stop_propagation"), &Alert::stop_propagation);
+    ClassDB::bind_method(D_METHOD("is_propagation_stopped"), &Alert::is_propagation_stopped);
+    ClassDB::bind_static_method("Alert", D_METHOD("intern_type", "name"), &Alert::intern_type);
+    ClassDB::bind_static_method("Alert", D_METHOD("find_type", "name"), &Alert::find_type);
+    ClassDB::bind_static_method("Alert", D_METHOD("get_type_name", "type"), &Alert::get_type_name);
 }
 
 void Alert::set_alert_name(String new_name) {
     alert_name = new_name;
+    alert_type = intern_type(new_name);
 }
 
 String Alert::get_alert_name() {
     return alert_name;
 }
 
+int Alert::get_alert_type() {
+    if(alert_type < 0){
+        alert_type = intern_type(alert_name);
+    }
+    return alert_type;
+}
+
+void Alert::set_sender(Object* sender) {
+    sender_id = sender ? ObjectID(sender->get_instance_id()) : ObjectID();
+}
+
+Object* Alert::get_sender() const {
+    return ObjectDB::get_instance(sender_id);
+}
+
+void Alert::set_current_target(Object* target) {
+    current_target_id = target ? ObjectID(target->get_instance_id()) : ObjectID();
+}
+
+Object* Alert::get_current_target() const {
+    return ObjectDB::get_instance(current_target_id);
+}
+
+void Alert::stop_propagation() {
+    propagation_stopped = true;
+}
+
+bool Alert::is_propagation_stopped() const {
+    return propagation_stopped;
+}
+
+int Alert::get_merge_key() const {
+    return 0;
+}
+
+int Alert::intern_type(const String& name) {
+    std::string name_str(name.utf8().get_data());
+    std::lock_guard<std::mutex> lock(get_types_mutex());
+    auto& type_ids = get_type_ids();
+    auto found = type_ids.find(name_str);
+    if(found != type_ids.end()){
+        return found->second;
+    }
+
+    auto& type_names = get_type_names();
+    int type = (int)type_names.size();
+    type_names.push_back(name_str);
+    type_ids.emplace(std::move(name_str), type);
+    return type;
+}
+
+int Alert::find_type(const String& name) {
+    std::string name_str(name.utf8().get_data());
+    std::lock_guard<std::mutex> lock(get_types_mutex());
+    auto& type_ids = get_type_ids();
+    auto found = type_ids.find(name_str);
+    return found != type_ids.end() ? found->second : -1;
+}
+
+String Alert::get_type_name(int type) {
+    std::lock_guard<std::mutex> lock(get_types_mutex());
+    auto& type_names = get_type_names();
+    if(type < 0 || type >= (int)type_names.size()) return String();
+    return String::utf8(type_names[type].c_str());
+}
+
 bool Alert::_set(const StringName &p_name, const Variant &p_value){
     String name = p_name;
     if(name == "set_alert_name"){
@@ -1,47 +1,453 @@
 #include "core/systems/alert/alert_manager.h"
 #include "godot_cpp/variant/utility_functions.hpp"
-// std::function to godot equalivemt.
+#include <algorithm>
+#ifdef HARMONIA_ALERT_STATS
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <chrono>
+#endif
+
+AlertManager::~AlertManager(){
+    remove_pending_manager(this);
+    PostedAlert* posted = posted_alerts.exchange(nullptr, std::memory_order_acquire);
+    while(posted != nullptr){
+        PostedAlert* next = posted->next;
+        delete posted;
+        posted = next;
+    }
+}
 
 void AlertManager::dispatch_alert(Alert* alert){
     if(alert == nullptr){
         return;
     }
+    if(deferred_mode){
+        queue_alert(alert);
+        return;
+    }
+    dispatch_alert_immediate(alert);
+}
+
+void AlertManager::dispatch_alert_immediate(Alert* alert){
+    if(alert == nullptr){
+        return;
+    }
+
+    // The snapshot stays alive and unchanged for the whole dispatch, handlers can bind and unbind freely.
+    std::shared_ptr<const HandlerTable> table = std::atomic_load(&handlers);
+    int alert_type = alert->get_alert_type();
+#ifdef HARMONIA_ALERT_STATS
+    if(alert_type < 0) return;
+    TypeStats& stats = get_type_stats(alert_type);
+    stats.dispatches++;
+    stats.subscribers = alert_type < (int)table->size() && (*table)[alert_type] ? (int)(*table)[alert_type]->size() : 0;
+    uint64_t dispatch_nsec = 0;
+#endif
+    if(alert_type < 0 || alert_type >= (int)table->size() || !(*table)[alert_type]){
+#ifdef HARMONIA_ALERT_STATS
+        record_monitored_dispatch(alert_type, 0);
+#endif
+        return; // Nothing was ever bound to this type.
+    }
 
-    auto ascii_str = alert->get_alert_name().ascii();
-    const char* alert_name = ascii_str.ptr();
-    std::string alert_name_str(alert_name);
-    std::unordered_set<std::shared_ptr<std::function<void(Alert*)>>> bind_functions = binds[alert_name_str];
-    for (std::shared_ptr<std::function<void(Alert*)>> func : bind_functions)
+    for (const Handler& handler : *(*table)[alert_type])
     {
-        (*func)(alert);
+        if(!handler.active->load(std::memory_order_acquire)) continue;
+#ifdef HARMONIA_ALERT_STATS
+        auto start = std::chrono::steady_clock::now();
+#endif
+        if(handler.function){
+            (*handler.function)(alert);
+        }else{
+            handler.callable.call(alert);
+        }
+#ifdef HARMONIA_ALERT_STATS
+        uint64_t nsec = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        handler.stats->record(nsec);
+        // A handler can dispatch alerts of new types, growing the table the reference points into.
+        get_type_stats(alert_type).handlers.record(nsec);
+        dispatch_nsec += nsec;
+#endif
     }
+#ifdef HARMONIA_ALERT_STATS
+    record_monitored_dispatch(alert_type, dispatch_nsec);
+#endif
+}
+
+void AlertManager::post_alert(Alert* alert){
+    if(alert == nullptr){
+        return;
+    }
+
+    PostedAlert* posted = new PostedAlert();
+    posted->alert = Ref<Alert>(alert);
+    PostedAlert* head = posted_alerts.load(std::memory_order_relaxed);
+    do {
+        posted->next = head;
+    } while(!posted_alerts.compare_exchange_weak(head, posted, std::memory_order_release, std::memory_order_relaxed));
+
+    // One drain per batch of posts, the flag is cleared by the drain before it takes the queue.
+    if(!drain_scheduled.exchange(true, std::memory_order_acq_rel)){
+        call_deferred("drain_posted_alerts");
+    }
+}
+
+void AlertManager::drain_posted_alerts(){
+    drain_scheduled.store(false, std::memory_order_release);
+    PostedAlert* posted = posted_alerts.exchange(nullptr, std::memory_order_acquire);
+
+    // The queue is newest first, reversed into the posting order.
+    PostedAlert* ordered = nullptr;
+    while(posted != nullptr){
+        PostedAlert* next = posted->next;
+        posted->next = ordered;
+        ordered = posted;
+        posted = next;
+    }
+
+    while(ordered != nullptr){
+        PostedAlert* next = ordered->next;
+        dispatch_alert(ordered->alert.ptr());
+        delete ordered;
+        ordered = next;
+    }
+}
+
+void AlertManager::add_bind(int alert_type, std::shared_ptr<std::function<void(Alert*)>> function){
+    if(!function) return;
+    Handler handler;
+    handler.function = function;
+    add_handler(alert_type, handler);
+}
+
+void AlertManager::remove_bind(int alert_type, std::shared_ptr<std::function<void(Alert*)>> function){
+    remove_handler(alert_type, [&function](const Handler& handler){
+        return handler.function == function;
+    });
 }
 
 void AlertManager::add_bind(std::string alert_type, std::shared_ptr<std::function<void(Alert*)>> function){
-    binds[alert_type].insert(function);
+    add_bind(Alert::intern_type(String::utf8(alert_type.c_str())), function);
 }
 
 void AlertManager::remove_bind(std::string alert_type, std::shared_ptr<std::function<void(Alert*)>> function){
-    binds[alert_type].erase(function);
+    // Unknown types (-1) have nothing bound, looking them up doesn't intern them.
+    remove_bind(Alert::find_type(String::utf8(alert_type.c_str())), function);
 }
 
 void AlertManager::godot_add_bind(String alert_type, Callable callable){
-    const char* alert_type_char = alert_type.ascii().ptr();
-    std::function<void(Alert*)> func = [callable](Alert* alert){
-        callable.call(alert);
+    Handler handler;
+    handler.callable = callable;
+    add_handler(Alert::intern_type(alert_type), handler);
+}
+
+void AlertManager::godot_remove_bind(String alert_type, Callable callable){
+    remove_handler(Alert::find_type(alert_type), [&callable](const Handler& handler){
+        return !handler.function && handler.callable == callable;
+    });
+}
+
+int AlertManager::get_bind_count(String alert_type){
+    std::shared_ptr<const HandlerTable> table = std::atomic_load(&handlers);
+    int type = Alert::find_type(alert_type);
+    if(type < 0 || type >= (int)table->size() || !(*table)[type]) return 0;
+    return (int)(*table)[type]->size();
+}
+
+void AlertManager::set_deferred_mode(bool value){
+    deferred_mode = value;
+    if(!deferred_mode){
+        flush_alerts();
+    }
+}
+
+bool AlertManager::get_deferred_mode(){
+    return deferred_mode;
+}
+
+void AlertManager::queue_alert(Alert* alert){
+    QueueKey key {alert->sender_id.id, alert->get_alert_type(), alert->get_merge_key()};
+    auto found = queued_alerts.find(key);
+    if(found != queued_alerts.end()){
+        // The latest alert describes the latest state, it takes the place of the first one.
+        alert_queue[found->second] = Ref<Alert>(alert);
+        return;
+    }
+
+    queued_alerts.emplace(key, alert_queue.size());
+    alert_queue.push_back(Ref<Alert>(alert));
+    if(alert_queue.size() > 1 || flushing) return;
+
+    get_pending_managers().push_back(this);
+    // Flushes alerts queued outside of a layout pass, after it when one is scheduled earlier in the frame.
+    if(!flush_scheduled){
+        flush_scheduled = true;
+        call_deferred("flush_alerts");
+    }
+}
+
+void AlertManager::flush_alerts(){
+    if(flushing) return;
+    flush_scheduled = false;
+    drain_posted_alerts();
+
+    flushing = true;
+    for (int pass = 0; pass < MAX_FLUSH_PASSES && !alert_queue.empty(); pass++)
+    {
+        flushing_alerts.swap(alert_queue);
+        queued_alerts.clear();
+        for (size_t i = 0; i < flushing_alerts.size(); i++)
+        {
+            dispatch_alert_immediate(flushing_alerts[i].ptr());
+        }
+        flushing_alerts.clear();
+    }
+    flushing = false;
+
+    remove_pending_manager(this);
+    if(!alert_queue.empty()){
+        // Handlers keep queueing alerts, the rest waits for the next flush instead of looping forever.
+        get_pending_managers().push_back(this);
+        if(!flush_scheduled){
+            flush_scheduled = true;
+            call_deferred("flush_alerts");
+        }
+    }
+}
+
+int AlertManager::get_queued_alert_count(){
+    return (int)alert_queue.size();
+}
+
+void AlertManager::flush_all_alerts(){
+    std::vector<AlertManager*>& pending = get_pending_managers();
+    // Managers still pending after their flush go to the back, every manager is flushed once.
+    size_t count = pending.size();
+    for (size_t i = 0; i < count && !pending.empty(); i++)
+    {
+        pending.front()->flush_alerts();
+    }
+}
+
+std::vector<AlertManager*>& AlertManager::get_pending_managers(){
+    static std::vector<AlertManager*> pending_managers;
+    return pending_managers;
+}
+
+void AlertManager::remove_pending_manager(AlertManager* manager){
+    std::vector<AlertManager*>& pending = get_pending_managers();
+    auto found = std::find(pending.begin(), pending.end(), manager);
+    if(found != pending.end()){
+        pending.erase(found);
+    }
+}
+
+bool AlertManager::is_alert_stats_enabled(){
+#ifdef HARMONIA_ALERT_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+Dictionary AlertManager::get_alert_stats(){
+    Dictionary stats;
+#ifdef HARMONIA_ALERT_STATS
+    std::shared_ptr<const HandlerTable> table = std::atomic_load(&handlers);
+    for (size_t type = 0; type < type_stats.size(); type++)
+    {
+        const TypeStats& current = type_stats[type];
+        if(current.dispatches == 0) continue;
+
+        Dictionary type_dictionary = current.handlers.to_dictionary();
+        type_dictionary["dispatches"] = (int64_t)current.dispatches;
+        type_dictionary["subscribers"] = current.subscribers;
+
+        Array handler_stats;
+        if(type < table->size() && (*table)[type]){
+            for (const Handler& handler : *(*table)[type])
+            {
+                Dictionary handler_dictionary = handler.stats->to_dictionary();
+                handler_dictionary["handler"] = handler.function ? Variant("native") : Variant(handler.callable);
+                handler_stats.push_back(handler_dictionary);
+            }
+        }
+        type_dictionary["handlers"] = handler_stats;
+        stats[Alert::get_type_name((int)type)] = type_dictionary;
+    }
+#endif
+    return stats;
+}
+
+void AlertManager::reset_alert_stats(){
+#ifdef HARMONIA_ALERT_STATS
+    type_stats.clear();
+    std::shared_ptr<const HandlerTable> table = std::atomic_load(&handlers);
+    for (const std::shared_ptr<const HandlerList>& list : *table)
+    {
+        if(!list) continue;
+        for (const Handler& handler : *list)
+        {
+            *handler.stats = AlertLatencyStats();
+        }
+    }
+#endif
+}
+
+#ifdef HARMONIA_ALERT_STATS
+namespace {
+    /// @brief Totals of all managers per alert type, shown by the Performance monitors.
+    struct MonitoredType {
+        uint64_t dispatches {0};
+        uint64_t handler_nsec {0};
+        bool registered {false};
     };
 
-    auto shared_func = std::make_shared<std::function<void(Alert*)>>(func);
-    godot_binds[alert_type_char][callable.hash()] = shared_func;
-    binds[alert_type_char].insert(shared_func);
+    std::vector<MonitoredType>& get_monitored_types(){
+        static std::vector<MonitoredType> monitored_types;
+        return monitored_types;
+    }
+
+    String get_monitor_id(int alert_type, const String& value){
+        return "Harmonia Alerts/" + Alert::get_type_name(alert_type) + " " + value;
+    }
 }
 
-// To be tested
-void AlertManager::godot_remove_bind(String alert_type, Callable callable){
-    const char* alert_type_char = alert_type.ascii().ptr();
-    std::shared_ptr<std::function<void(Alert*)>> shared_func = godot_binds[alert_type_char][callable.hash()];
-    binds[alert_type_char].erase(shared_func);
-    godot_binds[alert_type_char].erase(callable.hash());
+void AlertLatencyStats::record(uint64_t nsec){
+    calls++;
+    total_nsec += nsec;
+    max_nsec = std::max(max_nsec, nsec);
+
+    int bucket = 0;
+    uint64_t usec = nsec / 1000;
+    while(usec > 0 && bucket < HISTOGRAM_BUCKETS - 1){
+        usec >>= 1;
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+Dictionary AlertLatencyStats::to_dictionary() const{
+    Dictionary dictionary;
+    dictionary["calls"] = (int64_t)calls;
+    dictionary["total_usec"] = total_nsec / 1000.0;
+    dictionary["max_usec"] = max_nsec / 1000.0;
+    PackedInt64Array buckets;
+    buckets.resize(HISTOGRAM_BUCKETS);
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        buckets.ptrw()[i] = (int64_t)histogram[i];
+    }
+    dictionary["histogram"] = buckets;
+    return dictionary;
+}
+
+AlertManager::TypeStats& AlertManager::get_type_stats(int alert_type){
+    if(alert_type >= (int)type_stats.size()){
+        type_stats.resize(alert_type + 1);
+    }
+    return type_stats[alert_type];
+}
+
+void AlertManager::record_monitored_dispatch(int alert_type, uint64_t handler_nsec){
+    std::vector<MonitoredType>& monitored_types = get_monitored_types();
+    if(alert_type >= (int)monitored_types.size()){
+        monitored_types.resize(alert_type + 1);
+    }
+    MonitoredType& monitored = monitored_types[alert_type];
+    monitored.dispatches++;
+    monitored.handler_nsec += handler_nsec;
+
+    Performance* performance = Performance::get_singleton();
+    if(!monitored.registered && performance != nullptr){
+        monitored.registered = true;
+        performance->add_custom_monitor(get_monitor_id(alert_type, "dispatches"), callable_mp_static(&AlertManager::get_monitored_dispatches).bind(alert_type));
+        performance->add_custom_monitor(get_monitor_id(alert_type, "handler usec"), callable_mp_static(&AlertManager::get_monitored_handler_usec).bind(alert_type));
+    }
+}
+
+double AlertManager::get_monitored_dispatches(int alert_type){
+    std::vector<MonitoredType>& monitored_types = get_monitored_types();
+    if(alert_type < 0 || alert_type >= (int)monitored_types.size()) return 0;
+    return (double)monitored_types[alert_type].dispatches;
+}
+
+double AlertManager::get_monitored_handler_usec(int alert_type){
+    std::vector<MonitoredType>& monitored_types = get_monitored_types();
+    if(alert_type < 0 || alert_type >= (int)monitored_types.size()) return 0;
+    return monitored_types[alert_type].handler_nsec / 1000.0;
+}
+#endif
+
+void AlertManager::remove_stats_monitors(){
+#ifdef HARMONIA_ALERT_STATS
+    Performance* performance = Performance::get_singleton();
+    std::vector<MonitoredType>& monitored_types = get_monitored_types();
+    for (size_t type = 0; type < monitored_types.size(); type++)
+    {
+        if(!monitored_types[type].registered || performance == nullptr) continue;
+        for (const char* value : {"dispatches", "handler usec"})
+        {
+            String id = get_monitor_id((int)type, value);
+            if(performance->has_custom_monitor(id)){
+                performance->remove_custom_monitor(id);
+            }
+        }
+    }
+    monitored_types.clear();
+#endif
+}
+
+bool AlertManager::QueueKey::operator==(const QueueKey& other) const{
+    return sender == other.sender && type == other.type && merge_key == other.merge_key;
+}
+
+size_t AlertManager::QueueKeyHash::operator()(const QueueKey& key) const{
+    size_t hash = std::hash<uint64_t>()(key.sender);
+    hash ^= std::hash<int>()(key.type) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>()(key.merge_key) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+void AlertManager::add_handler(int alert_type, Handler handler){
+    if(alert_type < 0) return;
+    handler.active = std::make_shared<std::atomic<bool>>(true);
+#ifdef HARMONIA_ALERT_STATS
+    handler.stats = std::make_shared<AlertLatencyStats>();
+#endif
+
+    std::lock_guard<std::mutex> lock(handlers_mutex);
+    // Only the outer table and the changed list are copied, other lists are shared with the old snapshot.
+    std::shared_ptr<HandlerTable> table = std::make_shared<HandlerTable>(*handlers);
+    if(alert_type >= (int)table->size()){
+        table->resize(alert_type + 1);
+    }
+    std::shared_ptr<HandlerList> list = (*table)[alert_type] ? std::make_shared<HandlerList>(*(*table)[alert_type]) : std::make_shared<HandlerList>();
+    list->push_back(handler);
+    (*table)[alert_type] = list;
+    std::atomic_store(&handlers, std::shared_ptr<const HandlerTable>(table));
+}
+
+void AlertManager::remove_handler(int alert_type, const std::function<bool(const Handler&)>& matches){
+    if(alert_type < 0) return;
+
+    std::lock_guard<std::mutex> lock(handlers_mutex);
+    if(alert_type >= (int)handlers->size() || !(*handlers)[alert_type]) return;
+
+    const HandlerList& current = *(*handlers)[alert_type];
+    for (size_t i = 0; i < current.size(); i++)
+    {
+        if(!matches(current[i])) continue;
+        // Dispatches iterating the old snapshot might still reach it.
+        current[i].active->store(false, std::memory_order_release);
+
+        std::shared_ptr<HandlerTable> table = std::make_shared<HandlerTable>(*handlers);
+        std::shared_ptr<HandlerList> list = std::make_shared<HandlerList>(current);
+        list->erase(list->begin() + i);
+        (*table)[alert_type] = list;
+        std::atomic_store(&handlers, std::shared_ptr<const HandlerTable>(table));
+        return;
+    }
 }
 
 void AlertManager::_bind_methods()
@@ -49,4 +455,18 @@ void AlertManager::_bind_methods()
     ClassDB::bind_method(D_METHOD("dispatch_alert", "alert"), &AlertManager::dispatch_alert);
     ClassDB::bind_method(D_METHOD("add_bind", "alert_type", "function"), &AlertManager::godot_add_bind);
     ClassDB::bind_method(D_METHOD("remove_bind", "alert_type", "fuction"), &AlertManager::godot_remove_bind);
+    ClassDB::bind_method(D_METHOD("get_bind_count", "alert_type"), &AlertManager::get_bind_count);
+    ClassDB::bind_method(D_METHOD("dispatch_alert_immediate", "alert"), &AlertManager::dispatch_alert_immediate);
+    ClassDB::bind_method(D_METHOD("post_alert", "alert"), &AlertManager::post_alert);
+    ClassDB::bind_method(D_METHOD("drain_posted_alerts"), &AlertManager::drain_posted_alerts);
+    ClassDB::bind_method(D_METHOD("set_deferred_mode", "value"), &AlertManager::set_deferred_mode);
+    ClassDB::bind_method(D_METHOD("get_deferred_mode"), &AlertManager::get_deferred_mode);
+    ClassDB::bind_method(D_METHOD("flush_alerts"), &AlertManager::flush_alerts);
+    ClassDB::bind_method(D_METHOD("get_queued_alert_count"), &AlertManager::get_queued_alert_count);
+    ClassDB::bind_static_method("AlertManager", D_METHOD("flush_all_alerts"), &AlertManager::flush_all_alerts);
+    ClassDB::bind_static_method("AlertManager", D_METHOD("is_alert_stats_enabled"), &AlertManager::is_alert_stats_enabled);
+    ClassDB::bind_method(D_METHOD("get_alert_stats"), &AlertManager::get_alert_stats);
+    ClassDB::bind_method(D_METHOD("reset_alert_stats"), &AlertManager::reset_alert_stats);
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "deferred_mode"), "set_deferred_mode", "get_deferred_mode");
 }
@@ -1,13 +1,82 @@
 #include "core/systems/alert/layout/alert_layout_change.h"
 
-AlertLayoutChange::AlertLayoutChange(String name, LayoutChanged changed)
+AlertLayoutChange::AlertLayoutChange(String name, LayoutChanged changed) : Alert(name)
 {
-    alert_name = name;
     layout_changed = changed;
+    changed_mask = get_change_bit(changed);
+}
+
+AlertLayoutChange::AlertLayoutChange(int type, LayoutChanged changed) : Alert(type)
+{
+    layout_changed = changed;
+    changed_mask = get_change_bit(changed);
+}
+
+int AlertLayoutChange::get_layout_change_type()
+{
+    static const int type = intern_type("layout-change");
+    return type;
+}
+
+Ref<AlertLayoutChange> AlertLayoutChange::acquire(LayoutChanged changed, int changed_mask)
+{
+    Ref<AlertLayoutChange> alert = get_pool().acquire();
+    int type = get_layout_change_type();
+    if(alert->alert_type != type){
+        // Only new alerts (or renamed ones) need the name, reused ones keep it.
+        alert->alert_type = type;
+        alert->alert_name = get_type_name(type);
+    }
+    alert->layout_changed = changed;
+    alert->changed_mask = changed_mask;
+    alert->set_sender(nullptr);
+    alert->propagation_stopped = false;
+    return alert;
+}
+
+void AlertLayoutChange::clear_pool()
+{
+    get_pool().clear();
+}
+
+AlertPool<AlertLayoutChange>& AlertLayoutChange::get_pool()
+{
+    static AlertPool<AlertLayoutChange> pool;
+    return pool;
+}
+
+AlertLayoutChange::LayoutChanged AlertLayoutChange::get_layout_changed() const
+{
+    return layout_changed;
+}
+
+int AlertLayoutChange::get_changed_mask() const
+{
+    return changed_mask;
+}
+
+bool AlertLayoutChange::has_change(LayoutChanged changed) const
+{
+    return (changed_mask & get_change_bit(changed)) != 0;
+}
+
+int AlertLayoutChange::get_change_bit(LayoutChanged changed)
+{
+    return 1 << changed;
+}
+
+int AlertLayoutChange::get_merge_key() const
+{
+    return changed_mask;
 }
 
 void AlertLayoutChange::_bind_methods()
 {
+    ClassDB::bind_method(D_METHOD("get_layout_changed"), &AlertLayoutChange::get_layout_changed);
+    ClassDB::bind_method(D_METHOD("get_changed_mask"), &AlertLayoutChange::get_changed_mask);
+    ClassDB::bind_method(D_METHOD("has_change", "changed"), &AlertLayoutChange::has_change);
+
+    BIND_ENUM_CONSTANT(AlertLayoutChange::UNSPECIFIED);
     BIND_ENUM_CONSTANT(AlertLayoutChange::WIDTH);
     BIND_ENUM_CONSTANT(AlertLayoutChange::HEIGHT);
     BIND_ENUM_CONSTANT(AlertLayoutChange::POSITION);
@@ -0,0 +1,129 @@
+#include "core/systems/profiling/layout_profiler.h"
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <chrono>
+
+namespace {
+    struct MonitoredField {
+        const char* id;
+        uint64_t LayoutProfile::* field;
+        /// @brief Factor of the shown value, converts nanoseconds into microseconds.
+        double scale;
+    };
+
+    constexpr double NSEC_TO_USEC = 0.001;
+
+    const MonitoredField MONITORED_FIELDS[] = {
+        {"Harmonia Layout/relayouts", &LayoutProfile::relayouts, 1},
+        {"Harmonia Layout/layout usec", &LayoutProfile::layout_nsec, NSEC_TO_USEC},
+        {"Harmonia Layout/solve usec", &LayoutProfile::solve_nsec, NSEC_TO_USEC},
+        {"Harmonia Layout/overflow usec", &LayoutProfile::overflow_nsec, NSEC_TO_USEC},
+        {"Harmonia Layout/position usec", &LayoutProfile::position_nsec, NSEC_TO_USEC},
+        {"Harmonia Layout/set_position calls", &LayoutProfile::set_position_calls, 1},
+        {"Harmonia Layout/set_size calls", &LayoutProfile::set_size_calls, 1},
+    };
+
+    uint64_t now_nsec(){
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+void LayoutProfile::add(const LayoutProfile& other){
+    relayouts += other.relayouts;
+    layout_nsec += other.layout_nsec;
+    solve_nsec += other.solve_nsec;
+    overflow_nsec += other.overflow_nsec;
+    position_nsec += other.position_nsec;
+    set_position_calls += other.set_position_calls;
+    set_size_calls += other.set_size_calls;
+}
+
+Dictionary LayoutProfile::to_dictionary() const{
+    Dictionary dictionary;
+    dictionary["relayouts"] = (int64_t)relayouts;
+    dictionary["layout_usec"] = layout_nsec * NSEC_TO_USEC;
+    dictionary["solve_usec"] = solve_nsec * NSEC_TO_USEC;
+    dictionary["overflow_usec"] = overflow_nsec * NSEC_TO_USEC;
+    dictionary["position_usec"] = position_nsec * NSEC_TO_USEC;
+    dictionary["set_position_calls"] = (int64_t)set_position_calls;
+    dictionary["set_size_calls"] = (int64_t)set_size_calls;
+    return dictionary;
+}
+
+bool LayoutProfiler::is_enabled(){
+    return enabled;
+}
+
+void LayoutProfiler::set_enabled(bool value){
+    enabled = value;
+    if(enabled && !monitors_added){
+        add_monitors();
+    }
+}
+
+LayoutProfiler::Scope::Scope(LayoutProfile& profile, uint64_t LayoutProfile::* field){
+    if(!enabled) return;
+    this->profile = &profile;
+    this->field = field;
+    start = now_nsec();
+}
+
+LayoutProfiler::Scope::~Scope(){
+    if(profile == nullptr) return;
+    uint64_t elapsed = now_nsec() - start;
+    profile->*field += elapsed;
+    get_frame_totals().*field += elapsed;
+}
+
+void LayoutProfiler::count(LayoutProfile& profile, uint64_t LayoutProfile::* field, uint64_t amount){
+    if(!enabled) return;
+    profile.*field += amount;
+    get_frame_totals().*field += amount;
+}
+
+LayoutProfile LayoutProfiler::get_last_frame_totals(){
+    get_frame_totals(); // Rolls the totals over when no layout ran this frame yet.
+    return last_frame_totals;
+}
+
+LayoutProfile& LayoutProfiler::get_frame_totals(){
+    uint64_t current_frame = Engine::get_singleton()->get_process_frames();
+    if(current_frame != frame){
+        // Frames without any layout show zeros instead of the last frame that had some.
+        last_frame_totals = current_frame == frame + 1 ? frame_totals : LayoutProfile();
+        frame_totals = LayoutProfile();
+        frame = current_frame;
+    }
+    return frame_totals;
+}
+
+void LayoutProfiler::add_monitors(){
+    Performance* performance = Performance::get_singleton();
+    if(performance == nullptr) return;
+
+    monitors_added = true;
+    for (int i = 0; i < (int)(sizeof(MONITORED_FIELDS) / sizeof(MONITORED_FIELDS[0])); i++)
+    {
+        if(performance->has_custom_monitor(MONITORED_FIELDS[i].id)) continue;
+        performance->add_custom_monitor(MONITORED_FIELDS[i].id, callable_mp_static(&LayoutProfiler::get_monitor).bind(i));
+    }
+}
+
+void LayoutProfiler::remove_monitors(){
+    Performance* performance = Performance::get_singleton();
+    if(!monitors_added || performance == nullptr) return;
+
+    monitors_added = false;
+    for (const MonitoredField& monitored : MONITORED_FIELDS)
+    {
+        if(performance->has_custom_monitor(monitored.id)){
+            performance->remove_custom_monitor(monitored.id);
+        }
+    }
+}
+
+double LayoutProfiler::get_monitor(int field){
+    if(field < 0 || field >= (int)(sizeof(MONITORED_FIELDS) / sizeof(MONITORED_FIELDS[0]))) return 0;
+    return (double)(get_last_frame_totals().*MONITORED_FIELDS[field].field) * MONITORED_FIELDS[field].scale;
+}
@@ -1,6 +1,5 @@
 #include "core/harmonia.h"
 #include <godot_cpp/core/class_db.hpp>
-#include "commons/string_helper.h"
 
 using namespace godot;
 
@@ -10,27 +9,42 @@ LengthPair::LengthPair(Harmonia::Unit unit_type, double length)
     LengthPair::length = length;
 }
 
-LengthPair LengthPair::get_pair(String string_pair){
-    string_pair = replace(string_pair, " ", "");
-    String value_string;
-    String unit_string;
+// Parsed units are converted by value.
+static_assert((int)LengthParser::NOT_SET == (int)Harmonia::Unit::NOT_SET, "LengthParser units have to match Harmonia units");
+static_assert((int)LengthParser::PIXEL == (int)Harmonia::Unit::PIXEL, "LengthParser units have to match Harmonia units");
+static_assert((int)LengthParser::PERCENTAGE == (int)Harmonia::Unit::PERCENTAGE, "LengthParser units have to match Harmonia units");
+static_assert((int)LengthParser::VIEWPORT_WIDTH == (int)Harmonia::Unit::VIEWPORT_WIDTH, "LengthParser units have to match Harmonia units");
+static_assert((int)LengthParser::VIEWPORT_HEIGHT == (int)Harmonia::Unit::VIEWPORT_HEIGHT, "LengthParser units have to match Harmonia units");
+static_assert((int)LengthParser::FRACTION == (int)Harmonia::Unit::FRACTION, "LengthParser units have to match Harmonia units");
 
-    int stoppedAt {0};
-    value_string = get_string_number(string_pair, true, true, &stoppedAt);
-    for (size_t i = stoppedAt; i < string_pair.length(); i++)
-    {
-        unit_string += string_pair[i];
-    }
-    
-    double value = value_string.to_float();
-    Harmonia::Unit unit = get_unit(unit_string);
+LengthPair LengthPair::get_pair(const String& string_pair){
+    LengthPair pair;
+    parse(string_pair, pair);
+    return pair;
+}
 
-    // Converts into an actual float percentage
-    if(unit == Harmonia::Unit::PERCENTAGE){
-        value = value/100;
-    }
+LengthParser::Status LengthPair::parse(const String& string_pair, LengthPair& pair){
+    LengthParser::Result result;
+    LengthParser::Status status = LengthParser::parse(string_pair.ptr(), string_pair.length(), result);
+    pair.unit_type = static_cast<Harmonia::Unit>(result.unit);
+    pair.length = result.length;
+    return status;
+}
 
-    return LengthPair(unit, value);
+String LengthPair::get_parse_error(LengthParser::Status status){
+    switch (status)
+    {
+        case LengthParser::PARSE_EMPTY:
+            return "it is empty";
+        case LengthParser::PARSE_NO_NUMBER:
+            return "there is no number before the unit";
+        case LengthParser::PARSE_NO_UNIT:
+            return "the unit is missing (px, %, vw, vh or fr)";
+        case LengthParser::PARSE_UNKNOWN_UNIT:
+            return "the unit is unknown (px, %, vw, vh or fr)";
+        default:
+            return String();
+    }
 }
 
 String LengthPair::get_pair_str(LengthPair pair){
@@ -50,6 +64,9 @@ String LengthPair::get_pair_str(LengthPair pair){
         case Harmonia::Unit::VIEWPORT_HEIGHT:
             pair_str += "vh";
             break;
+        case Harmonia::Unit::FRACTION:
+            pair_str += "fr";
+            break;
         default:
             return pair_str + pair.unit_type;
     }
@@ -66,6 +83,8 @@ Harmonia::Unit LengthPair::get_unit(String unit_string){
         return Harmonia::Unit::VIEWPORT_HEIGHT;
     }else if(unit_string == "vw"){
         return Harmonia::Unit::VIEWPORT_WIDTH;
+    }else if(unit_string == "fr"){
+        return Harmonia::Unit::FRACTION;
     }else{
         return Harmonia::Unit::NOT_SET;
     }
@@ -87,8 +106,38 @@ void Harmonia::_bind_methods(){
     BIND_ENUM_CONSTANT(PERCENTAGE);
     BIND_ENUM_CONSTANT(VIEWPORT_WIDTH);
     BIND_ENUM_CONSTANT(VIEWPORT_HEIGHT);
+    BIND_ENUM_CONSTANT(FRACTION);
 
     BIND_ENUM_CONSTANT(OBJECT_VISIBLE);
     BIND_ENUM_CONSTANT(OBJECT_HIDDEN);
     BIND_ENUM_CONSTANT(OBJECT_TRANSPARENT);
+
+    BIND_ENUM_CONSTANT(LAYOUT_BLOCK);
+    BIND_ENUM_CONSTANT(LAYOUT_FLEX);
+    BIND_ENUM_CONSTANT(LAYOUT_GRID);
+
+    BIND_ENUM_CONSTANT(FLEX_ROW);
+    BIND_ENUM_CONSTANT(FLEX_ROW_REVERSE);
+    BIND_ENUM_CONSTANT(FLEX_COLUMN);
+    BIND_ENUM_CONSTANT(FLEX_COLUMN_REVERSE);
+
+    BIND_ENUM_CONSTANT(FLEX_NO_WRAP);
+    BIND_ENUM_CONSTANT(FLEX_WRAP);
+
+    BIND_ENUM_CONSTANT(JUSTIFY_START);
+    BIND_ENUM_CONSTANT(JUSTIFY_END);
+    BIND_ENUM_CONSTANT(JUSTIFY_CENTER);
+    BIND_ENUM_CONSTANT(JUSTIFY_SPACE_BETWEEN);
+    BIND_ENUM_CONSTANT(JUSTIFY_SPACE_AROUND);
+    BIND_ENUM_CONSTANT(JUSTIFY_SPACE_EVENLY);
+
+    BIND_ENUM_CONSTANT(ALIGN_START);
+    BIND_ENUM_CONSTANT(ALIGN_END);
+    BIND_ENUM_CONSTANT(ALIGN_CENTER);
+    BIND_ENUM_CONSTANT(ALIGN_STRETCH);
+
+    BIND_ENUM_CONSTANT(PICK_NONE);
+    BIND_ENUM_CONSTANT(PICK_CONTENT);
+    BIND_ENUM_CONSTANT(PICK_VERTICAL_SCROLLBAR);
+    BIND_ENUM_CONSTANT(PICK_HORIZONTAL_SCROLLBAR);
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "core/systems/alert/alert.h"
 #include "core/systems/alert/layout/alert_layout_change.h"
 #include "core/systems/alert/alert_manager.h"
+#include "benchmarks/harmonia_benchmarks.h"
 
 using namespace godot;
 
@@ -23,12 +24,20 @@ void initialize_harmonia(ModuleInitializationLevel p_level) {
 	GDREGISTER_CLASS(AlertManager);
 	GDREGISTER_CLASS(ContentBox);
 	GDREGISTER_CLASS(ContainerBox);
+#ifdef HARMONIA_BENCHMARKS
+	GDREGISTER_CLASS(HarmoniaBenchmarks);
+#endif
 }
 
 void deinitialize_harmonia(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+
+	// Pooled alerts are Godot objects, they can't outlive the extension in static storage.
+	AlertLayoutChange::clear_pool();
+	AlertManager::remove_stats_monitors();
+	LayoutProfiler::remove_monitors();
 }
 
 extern "C" {
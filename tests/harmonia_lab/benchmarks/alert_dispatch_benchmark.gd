@@ -0,0 +1,43 @@
+extends SceneTree
+## Measures AlertManager.dispatch_alert with 1, 10 and 1000 subscribers.
+## Run headless from the harmonia_lab directory:
+##   godot --headless -s res://benchmarks/alert_dispatch_benchmark.gd
+
+const SUBSCRIBER_COUNTS := [1, 10, 1000]
+## Total handler calls per measurement, dispatches are scaled down as subscribers go up.
+const CALLS_PER_RUN := 1000000
+const ALERT_TYPE := "benchmark-alert"
+
+var calls := 0
+
+
+func _init() -> void:
+	for subscribers in SUBSCRIBER_COUNTS:
+		run(subscribers)
+	quit()
+
+
+func on_alert(_alert: Alert) -> void:
+	calls += 1
+
+
+func run(subscribers: int) -> void:
+	var manager := AlertManager.new()
+	for i in subscribers:
+		# The same callable bound again is another subscriber.
+		manager.add_bind(ALERT_TYPE, on_alert)
+
+	# Alert itself is registered as a virtual class, scripts instantiate its subclasses.
+	var alert := AlertLayoutChange.new()
+	alert.set_alert_name(ALERT_TYPE)
+	var dispatches: int = max(CALLS_PER_RUN / subscribers, 1000)
+
+	calls = 0
+	var start := Time.get_ticks_usec()
+	for i in dispatches:
+		manager.dispatch_alert(alert)
+	var elapsed := Time.get_ticks_usec() - start
+
+	print("subscribers: %d, dispatches: %d, per dispatch: %.3f us, per handler: %.3f us (calls: %d)" % [
+		subscribers, dispatches, float(elapsed) / dispatches, float(elapsed) / calls, calls])
+	manager.free()
@@ -0,0 +1,65 @@
+extends SceneTree
+## Microbenchmarks of the String based commons (LengthPair parser, string helpers, ContainerUnitConverter).
+## Needs an extension built with the HarmoniaBenchmarks class: scons engine_benchmarks=yes
+## Run headless from the harmonia_lab directory:
+##   godot --headless -s res://benchmarks/commons_benchmark.gd
+## Options (after "--"):
+##   --output=<path>         Results file, defaults to user://benchmarks/commons_benchmark.json
+##   --iterations=<count>    Operations per benchmark, defaults to 200000
+##
+## Godot Strings allocate inside of the engine, which has no allocation counter, so allocation counts are NOT available
+## here. Debug builds report the static memory retained per operation and the rise of the static memory peak instead,
+## release builds report 0 for both. The native benchmarks (scons benchmarks) count allocations of the Godot independent code.
+
+const DEFAULT_OUTPUT := "user://benchmarks/commons_benchmark.json"
+const DEFAULT_ITERATIONS := 200000
+
+var iterations := DEFAULT_ITERATIONS
+var output_path := DEFAULT_OUTPUT
+
+
+func _initialize() -> void:
+	parse_arguments()
+	if not ClassDB.class_exists("HarmoniaBenchmarks"):
+		push_error("HarmoniaBenchmarks is missing, build the extension with: scons engine_benchmarks=yes")
+		quit(1)
+		return
+
+	var benchmarks = ClassDB.instantiate("HarmoniaBenchmarks")
+	var results: Array = benchmarks.run_commons(iterations)
+	for result in results:
+		print("%-44s %10.1f ns/op %14.0f ops/s %10.2f B/op retained %10d B peak" % [result["name"], result["nsec_per_op"],
+			result["ops_per_sec"], result["static_memory_delta_per_op"], result["static_memory_peak_delta"]])
+	if not OS.is_debug_build():
+		print("Release build, static memory isn't tracked.")
+
+	write_report({
+		"engine": Engine.get_version_info()["string"],
+		"debug_build": OS.is_debug_build(),
+		"platform": OS.get_name(),
+		"processor": OS.get_processor_name(),
+		"timestamp": Time.get_datetime_string_from_system(true),
+		"iterations": iterations,
+		"allocation_counts": "unavailable, engine allocations can't be counted from the extension; static_memory_* fields are debug build only",
+		"benchmarks": results,
+	})
+	quit()
+
+
+func parse_arguments() -> void:
+	for argument in OS.get_cmdline_user_args():
+		if argument.begins_with("--output="):
+			output_path = argument.trim_prefix("--output=")
+		elif argument.begins_with("--iterations="):
+			iterations = max(int(argument.trim_prefix("--iterations=")), 1)
+
+
+func write_report(report: Dictionary) -> void:
+	DirAccess.make_dir_recursive_absolute(output_path.get_base_dir())
+	var file := FileAccess.open(output_path, FileAccess.WRITE)
+	if file == null:
+		push_error("Cannot write results to %s: %s" % [output_path, error_string(FileAccess.get_open_error())])
+		return
+	file.store_string(JSON.stringify(report, "\t"))
+	file.close()
+	print("Results written to ", ProjectSettings.globalize_path(output_path))
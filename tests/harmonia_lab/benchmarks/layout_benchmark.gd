@@ -0,0 +1,289 @@
+extends SceneTree
+## Stress benchmarks of HarmoniaUI layout on generated scenes, results are written as JSON.
+## Run headless from the harmonia_lab directory:
+##   godot --headless -s res://benchmarks/layout_benchmark.gd
+## Options (after "--"):
+##   --output=<path>     Results file, defaults to user://benchmarks/layout_benchmark.json
+##   --frames=<count>    Measured frames per scenario, defaults to 300
+##   --only=<name,...>   Runs only the listed scenarios
+##   --profile           Enables the layout profiler and adds its totals (slows the layout down)
+##   --backgrounds=<mode>  unbatched, batched or both (default), runs the scenarios with batch_backgrounds off and/or on
+##
+## Every scenario builds a tree, changes it each frame and forces the layout with flush_layout, which is timed.
+## Frame time is the time between process frames, so it includes the deferred work, culling and scrolling.
+## Memory is the static memory delta (debug builds only, 0 in release builds) and the object count delta.
+
+const DEFAULT_OUTPUT := "user://benchmarks/layout_benchmark.json"
+const DEFAULT_FRAMES := 300
+const WARMUP_FRAMES := 20
+## Same sequence of random choices on every run, so builds get the same work.
+const SEED := 1234
+
+var frames := DEFAULT_FRAMES
+var output_path := DEFAULT_OUTPUT
+var only: PackedStringArray = []
+var profile := false
+var background_modes := [false, true]
+var rng := RandomNumberGenerator.new()
+
+
+func _initialize() -> void:
+	parse_arguments()
+	run_all()
+
+
+func parse_arguments() -> void:
+	for argument in OS.get_cmdline_user_args():
+		if argument.begins_with("--output="):
+			output_path = argument.trim_prefix("--output=")
+		elif argument.begins_with("--frames="):
+			frames = max(int(argument.trim_prefix("--frames=")), 1)
+		elif argument.begins_with("--only="):
+			only = argument.trim_prefix("--only=").split(",", false)
+		elif argument == "--profile":
+			profile = true
+		elif argument.begins_with("--backgrounds="):
+			match argument.trim_prefix("--backgrounds="):
+				"unbatched":
+					background_modes = [false]
+				"batched":
+					background_modes = [true]
+				_:
+					background_modes = [false, true]
+
+
+func run_all() -> void:
+	var scenarios := [
+		["deep_nesting", build_deep_nesting, step_resize_root],
+		["wide_list", build_wide_list, step_resize_root],
+		["mixed_units", build_mixed_units, step_resize_root],
+		["heavy_scrolling", build_heavy_scrolling, step_scroll],
+		["property_churn", build_property_churn, step_churn],
+	]
+
+	ContainerBox.set_layout_profiling(profile)
+	var results := []
+	for batched in background_modes:
+		for scenario in scenarios:
+			if not only.is_empty() and not only.has(scenario[0]):
+				continue
+			results.append(await run_scenario(scenario[0], scenario[1], scenario[2], batched))
+
+	var report := {
+		"engine": Engine.get_version_info()["string"],
+		"debug_build": OS.is_debug_build(),
+		"platform": OS.get_name(),
+		"processor": OS.get_processor_name(),
+		"timestamp": Time.get_datetime_string_from_system(true),
+		"frames": frames,
+		"profile": profile,
+		"scenarios": results,
+	}
+	write_report(report)
+	quit()
+
+
+func run_scenario(scenario_name: String, build: Callable, step: Callable, batched: bool) -> Dictionary:
+	rng.seed = SEED
+	var objects_before := Performance.get_monitor(Performance.OBJECT_COUNT)
+	var memory_before := Performance.get_monitor(Performance.MEMORY_STATIC)
+
+	var root: ContainerBox = build.call()
+	root.set_batch_backgrounds(batched)
+	get_root().add_child(root)
+	await process_frame
+	root.flush_layout()
+
+	var layout_times := PackedFloat64Array()
+	var frame_times := PackedFloat64Array()
+	var last_frame := Time.get_ticks_usec()
+	for frame in WARMUP_FRAMES + frames:
+		step.call(root, frame)
+		var start := Time.get_ticks_usec()
+		root.flush_layout()
+		var layout_time := Time.get_ticks_usec() - start
+
+		await process_frame
+		var now := Time.get_ticks_usec()
+		if frame >= WARMUP_FRAMES:
+			layout_times.append(layout_time)
+			frame_times.append(now - last_frame)
+		last_frame = now
+
+	var result := {
+		"name": scenario_name,
+		"batch_backgrounds": batched,
+		"node_count": count_nodes(root),
+		"container_count": count_containers(root),
+		"layout_usec": summarize(layout_times),
+		"frame_usec": summarize(frame_times),
+		"static_memory_delta": Performance.get_monitor(Performance.MEMORY_STATIC) - memory_before,
+		"object_count_delta": Performance.get_monitor(Performance.OBJECT_COUNT) - objects_before,
+	}
+	if profile:
+		result["layout_profile"] = root.get_layout_profile()["subtree"]
+
+	root.queue_free()
+	await process_frame
+	print("%s%s: layout mean %.1f us, p99 %.1f us, frame mean %.1f us (%d nodes)" % [
+		scenario_name, " (batched)" if batched else "", result["layout_usec"]["mean"], result["layout_usec"]["p99"], result["frame_usec"]["mean"], result["node_count"]])
+	return result
+
+
+## NOTE: Scenarios, builders return the root container and steps change the tree every frame.
+
+## A chain of nested containers, each one padded, resized through the root.
+func build_deep_nesting() -> ContainerBox:
+	var root := make_container("100vw", "100vh")
+	var current := root
+	for depth in 128:
+		var child := make_container("100%", "auto")
+		child.set_padding_str("2px")
+		current.add_child(child)
+		current = child
+	var leaf := make_container("100%", "20px")
+	current.add_child(leaf)
+	return root
+
+
+## A flex column with thousands of rows.
+func build_wide_list() -> ContainerBox:
+	var root := make_container("100vw", "100vh")
+	root.set_overflow_behaviour(Harmonia.VISIBLE)
+	root.set_layout_mode(Harmonia.LAYOUT_FLEX)
+	root.set_flex_direction(Harmonia.FLEX_COLUMN)
+	for i in 4000:
+		var row := make_container("100%", "24px")
+		row.set_margin_str("1px")
+		root.add_child(row)
+	return root
+
+
+## A wrapping flex row with children sized in every unit.
+func build_mixed_units() -> ContainerBox:
+	var root := make_container("100vw", "100vh")
+	root.set_overflow_behaviour(Harmonia.VISIBLE)
+	root.set_layout_mode(Harmonia.LAYOUT_FLEX)
+	root.set_flex_wrap(Harmonia.FLEX_WRAP)
+	var widths := ["40px", "5%", "3vw", "4vh"]
+	var heights := ["30px", "2%", "2vw", "5vh"]
+	for i in 1500:
+		var child := make_container(widths[rng.randi() % widths.size()], heights[rng.randi() % heights.size()])
+		child.set_padding_str("1%")
+		child.set_margin_str("0.2vw")
+		root.add_child(child)
+	return root
+
+
+## Scrolled containers with long content, scrolled every frame. Culling is on, so rows leaving the view are culled.
+func build_heavy_scrolling() -> ContainerBox:
+	var root := make_container("100vw", "100vh")
+	root.set_overflow_behaviour(Harmonia.VISIBLE)
+	root.set_layout_mode(Harmonia.LAYOUT_FLEX)
+	for column in 4:
+		var scrolled := make_container("25%", "100%")
+		scrolled.set_culling(true)
+		var content := ContentBox.new()
+		content.set_smooth_scrolling(true)
+		scrolled.add_child(content)
+		for i in 1000:
+			content.add_child(make_container("100%", "32px"))
+		root.add_child(scrolled)
+	return root
+
+
+## Containers whose properties change every frame.
+func build_property_churn() -> ContainerBox:
+	var root := make_container("100vw", "100vh")
+	root.set_overflow_behaviour(Harmonia.VISIBLE)
+	root.set_layout_mode(Harmonia.LAYOUT_FLEX)
+	root.set_flex_wrap(Harmonia.FLEX_WRAP)
+	for i in 800:
+		root.add_child(make_container("48px", "48px"))
+	return root
+
+
+func step_resize_root(root: ContainerBox, frame: int) -> void:
+	root.set_width_str("100vw" if frame % 2 == 0 else "99vw")
+
+
+func step_scroll(root: ContainerBox, frame: int) -> void:
+	# Scrolls down and back up, so the content doesn't stop at its end.
+	var direction := 1.0 if (frame / 60) % 2 == 0 else -1.0
+	for scrolled in root.get_children():
+		for child in scrolled.get_children():
+			if child is ContentBox:
+				child.add_scroll_velocity(Vector2(0, 400 * direction))
+
+
+func step_churn(root: ContainerBox, _frame: int) -> void:
+	var children := root.get_children()
+	for i in 100:
+		var child: ContainerBox = children[rng.randi() % children.size()]
+		match rng.randi() % 4:
+			0:
+				child.set_width_str("%dpx" % rng.randi_range(32, 64))
+			1:
+				child.set_padding_str("%dpx %d%%" % [rng.randi_range(0, 4), rng.randi_range(0, 5)])
+			2:
+				child.set_margin_str("%dpx" % rng.randi_range(0, 6))
+			3:
+				child.set_background_color(Color(rng.randf(), rng.randf(), rng.randf()))
+
+
+## NOTE: Helpers
+
+func make_container(width: String, height: String) -> ContainerBox:
+	var container := ContainerBox.new()
+	container.set_width_str(width)
+	if height != "auto":
+		container.set_height_str(height)
+	return container
+
+
+func count_nodes(node: Node) -> int:
+	var count := 1
+	for child in node.get_children():
+		count += count_nodes(child)
+	return count
+
+
+func count_containers(node: Node) -> int:
+	var count := 1 if node is ContainerBox else 0
+	for child in node.get_children():
+		count += count_containers(child)
+	return count
+
+
+func summarize(samples: PackedFloat64Array) -> Dictionary:
+	if samples.is_empty():
+		return {"mean": 0.0, "p50": 0.0, "p95": 0.0, "p99": 0.0, "max": 0.0}
+	var sorted := samples.duplicate()
+	sorted.sort()
+	var total := 0.0
+	for sample in sorted:
+		total += sample
+	return {
+		"mean": total / sorted.size(),
+		"p50": percentile(sorted, 0.50),
+		"p95": percentile(sorted, 0.95),
+		"p99": percentile(sorted, 0.99),
+		"max": sorted[sorted.size() - 1],
+	}
+
+
+## Nearest rank percentile of sorted samples.
+func percentile(sorted: PackedFloat64Array, fraction: float) -> float:
+	var index := clampi(ceili(fraction * sorted.size()) - 1, 0, sorted.size() - 1)
+	return sorted[index]
+
+
+func write_report(report: Dictionary) -> void:
+	DirAccess.make_dir_recursive_absolute(output_path.get_base_dir())
+	var file := FileAccess.open(output_path, FileAccess.WRITE)
+	if file == null:
+		push_error("Cannot write results to %s: %s" % [output_path, error_string(FileAccess.get_open_error())])
+		return
+	file.store_string(JSON.stringify(report, "\t"))
+	file.close()
+	print("Results written to ", ProjectSettings.globalize_path(output_path))
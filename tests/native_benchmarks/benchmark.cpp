@@ -0,0 +1,73 @@
+#include "benchmark.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+std::atomic<uint64_t> benchmark::allocation_count {0};
+
+void* operator new(std::size_t size){
+    benchmark::allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if(void* pointer = std::malloc(size == 0 ? 1 : size)){
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size){
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept{
+    std::free(pointer);
+}
+
+void benchmark::print(const std::vector<Result>& results, bool json){
+    if(json){
+        std::printf("[\n");
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& result = results[i];
+            std::printf("\t{\"name\": \"%s\", \"iterations\": %llu, \"total_msec\": %.3f, \"nsec_per_op\": %.3f, \"ops_per_sec\": %.0f, \"allocations_per_op\": %.3f}%s\n",
+                result.name.c_str(), (unsigned long long)result.iterations, result.total_msec, result.nsec_per_op,
+                result.ops_per_sec, result.allocations_per_op, i + 1 < results.size() ? "," : "");
+        }
+        std::printf("]\n");
+        return;
+    }
+
+    std::printf("%-64s %12s %14s %12s\n", "benchmark", "ns/op", "ops/s", "allocs/op");
+    for (const Result& result : results)
+    {
+        std::printf("%-64s %12.2f %14.0f %12.3f\n", result.name.c_str(), result.nsec_per_op, result.ops_per_sec, result.allocations_per_op);
+    }
+}
+
+int main(int argc, char** argv){
+    bool json = false;
+    double scale = 1;
+    const char* only = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if(std::strcmp(argv[i], "--json") == 0) json = true;
+        else if(std::strncmp(argv[i], "--scale=", 8) == 0) scale = std::atof(argv[i] + 8);
+        else if(std::strncmp(argv[i], "--only=", 7) == 0) only = argv[i] + 7;
+    }
+
+    std::vector<benchmark::Result> results;
+    if(only == nullptr || std::strcmp(only, "commons") == 0) benchmark::run_commons(results, scale);
+    if(only == nullptr || std::strcmp(only, "layout") == 0) benchmark::run_layout(results, scale);
+    benchmark::print(results, json);
+    return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// @brief Minimal harness of the native benchmarks, measures throughput and heap allocations of a function.
+///
+/// Allocations are counted by the global operator new of the benchmark executable (see benchmark.cpp), so only
+/// allocations made through new (including standard containers) are seen.
+///
+/// Build and run with: scons benchmarks && ./build/harmonia_benchmarks [--json] [--scale=<factor>] [--only=commons|layout]
+namespace benchmark {
+
+    /// @brief Heap allocations since the start of the process.
+    extern std::atomic<uint64_t> allocation_count;
+
+    struct Result {
+        std::string name;
+        uint64_t iterations {0};
+        double total_msec {0};
+        double nsec_per_op {0};
+        double ops_per_sec {0};
+        double allocations_per_op {0};
+    };
+
+    /// @brief Keeps a value alive, so the measured work isn't optimized out.
+    template <class T>
+    inline void keep(const T& value){
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    /// @brief Runs a function for a number of iterations after a short warm-up.
+    /// @param function Called with the iteration index, does one operation
+    template <class Function>
+    Result run(const std::string& name, uint64_t iterations, Function function){
+        for (uint64_t i = 0; i < iterations / 10 + 1; i++)
+        {
+            function(i);
+        }
+
+        uint64_t allocations = allocation_count.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            function(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        allocations = allocation_count.load(std::memory_order_relaxed) - allocations;
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.total_msec = std::chrono::duration<double, std::milli>(elapsed).count();
+        result.nsec_per_op = result.total_msec * 1e6 / iterations;
+        result.ops_per_sec = result.nsec_per_op > 0 ? 1e9 / result.nsec_per_op : 0;
+        result.allocations_per_op = (double)allocations / iterations;
+        return result;
+    }
+
+    /// @brief Prints results as a table, or as JSON for comparing builds.
+    void print(const std::vector<Result>& results, bool json);
+
+    /// @brief Length parser and unit conversions (commons_benchmark.cpp)
+    /// @param scale Factor of the iteration counts
+    void run_commons(std::vector<Result>& results, double scale);
+
+    /// @brief LayoutSolver on trees of 100k nodes (layout_benchmark.cpp)
+    /// @param scale Factor of the iteration counts
+    void run_layout(std::vector<Result>& results, double scale);
+}
@@ -0,0 +1,93 @@
+#include "benchmark.h"
+#include "commons/length_parser.h"
+#include "commons/unit_conversion.h"
+#include "core/layout/unit_batch.h"
+
+/// Native benchmarks of the Godot independent length parser and unit conversions, the String based parts of commons/
+/// need the engine and are measured by HarmoniaBenchmarks (tests/harmonia_lab/benchmarks/commons_benchmark.gd)
+
+namespace {
+    /// @brief Lengths of realistic property values ("10px", "50%", "1'000.5vw", "4vh", "12.5px" and "0.5%")
+    struct Length {
+        int unit;
+        double length;
+    };
+
+    const Length LENGTHS[] = {
+        {UnitConversion::PIXEL, 10},
+        {UnitConversion::PERCENTAGE, 0.5},
+        {UnitConversion::VIEWPORT_WIDTH, 1000.5},
+        {UnitConversion::VIEWPORT_HEIGHT, 4},
+        {UnitConversion::PIXEL, 12.5},
+        {UnitConversion::PERCENTAGE, 0.005},
+    };
+    constexpr size_t LENGTH_COUNT = sizeof(LENGTHS) / sizeof(LENGTHS[0]);
+
+    /// @brief Property values as Godot stores them (UTF-32), with readable digits and spaces the parser has to skip.
+    const std::u32string LENGTH_STRINGS[] = {U"10px", U"50%", U"1'000.5vw", U"4vh", U" 12.5 px ", U"0.5%", U"-8px", U"1fr"};
+    constexpr size_t LENGTH_STRING_COUNT = sizeof(LENGTH_STRINGS) / sizeof(LENGTH_STRINGS[0]);
+
+    const UnitContext CONTEXT {800, 600, 1920, 1080};
+
+    /// @brief Lengths of a layout pass converted at once, a few thousand containers.
+    constexpr size_t BATCH_SIZE = 4096;
+}
+
+void benchmark::run_commons(std::vector<Result>& results, double scale){
+    auto iterations = [scale](uint64_t count){
+        return (uint64_t)(count * scale) + 1;
+    };
+
+    results.push_back(benchmark::run("LengthParser::parse", iterations(20000000), [](uint64_t i){
+        const std::u32string& string = LENGTH_STRINGS[i % LENGTH_STRING_COUNT];
+        LengthParser::Result result;
+        benchmark::keep(LengthParser::parse(string.data(), (int64_t)string.size(), result));
+        benchmark::keep(result);
+    }));
+
+    results.push_back(benchmark::run("UnitConverter::percentage_to_px", iterations(50000000), [](uint64_t i){
+        benchmark::keep(UnitConverter::percentage_to_px(LENGTHS[i % LENGTH_COUNT].length, CONTEXT.parent_width));
+    }));
+
+    results.push_back(benchmark::run("UnitConverter::vw_to_percentage", iterations(50000000), [](uint64_t i){
+        benchmark::keep(UnitConverter::vw_to_percentage(LENGTHS[i % LENGTH_COUNT].length, CONTEXT.viewport_width, CONTEXT.parent_width));
+    }));
+
+    results.push_back(benchmark::run("UnitConversion::convert<VW, PIXEL, WIDTH>", iterations(50000000), [](uint64_t i){
+        benchmark::keep(UnitConversion::convert<UnitConversion::VIEWPORT_WIDTH, UnitConversion::PIXEL, UnitAxis::WIDTH>(LENGTHS[i % LENGTH_COUNT].length, CONTEXT));
+    }));
+
+    results.push_back(benchmark::run("UnitConversion::convert_to<PIXEL> (runtime from)", iterations(50000000), [](uint64_t i){
+        const Length& length = LENGTHS[i % LENGTH_COUNT];
+        benchmark::keep(UnitConversion::convert_to<UnitConversion::PIXEL, UnitAxis::WIDTH>(length.unit, length.length, CONTEXT));
+    }));
+
+    results.push_back(benchmark::run("UnitConversion::convert (runtime from, to)", iterations(50000000), [](uint64_t i){
+        const Length& length = LENGTHS[i % LENGTH_COUNT];
+        int to = (int)((i / LENGTH_COUNT) % UnitConversion::UNIT_COUNT);
+        benchmark::keep(UnitConversion::convert(length.unit, to, i % 2 ? UnitAxis::HEIGHT : UnitAxis::WIDTH, length.length, CONTEXT));
+    }));
+
+    UnitBatch batch;
+    for (size_t i = 0; i < BATCH_SIZE; i++)
+    {
+        const Length& length = LENGTHS[i % LENGTH_COUNT];
+        batch.push(length.unit, length.length, 300 + (double)(i % 500));
+    }
+    batch.results.resize(batch.size());
+    for (int kernel = UnitBatch::KERNEL_SCALAR; kernel <= UnitBatch::KERNEL_NEON; kernel++)
+    {
+        if(!UnitBatch::is_kernel_supported(static_cast<UnitBatch::Kernel>(kernel))) continue;
+        std::string name = std::string("UnitBatch::to_pixels ") + UnitBatch::get_kernel_name(static_cast<UnitBatch::Kernel>(kernel)) + " (per length)";
+        benchmark::Result result = benchmark::run(name, iterations(20000), [&batch, kernel](uint64_t){
+            UnitBatch::to_pixels(static_cast<UnitBatch::Kernel>(kernel), batch.units.data(), batch.lengths.data(), batch.parent_sizes.data(),
+                CONTEXT.viewport_width, CONTEXT.viewport_height, batch.results.data(), batch.size());
+            benchmark::keep(batch.results[0]);
+        });
+        // Reported per converted length, comparable with the single conversions above.
+        result.nsec_per_op /= BATCH_SIZE;
+        result.ops_per_sec *= BATCH_SIZE;
+        result.allocations_per_op /= BATCH_SIZE;
+        results.push_back(result);
+    }
+}
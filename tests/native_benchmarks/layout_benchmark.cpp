@@ -0,0 +1,135 @@
+#include "benchmark.h"
+#include "core/layout/layout_solver.h"
+
+/// Native benchmarks of the LayoutSolver on a tree of about 100k nodes (root, 100 sections, 1000 groups, 99000 leaves),
+/// results are reported per laid out node.
+
+namespace {
+    constexpr int SECTION_COUNT = 100;
+    constexpr int GROUPS_PER_SECTION = 10;
+    constexpr int LEAVES_PER_GROUP = 99;
+    constexpr size_t NODE_COUNT = 1 + SECTION_COUNT + SECTION_COUNT * GROUPS_PER_SECTION + SECTION_COUNT * GROUPS_PER_SECTION * LEAVES_PER_GROUP;
+
+    constexpr double VIEWPORT_WIDTH = 1920;
+    constexpr double VIEWPORT_HEIGHT = 1080;
+
+    LayoutNode::Length length(double value, LayoutNode::Unit unit){
+        LayoutNode::Length result;
+        result.unit_type = unit;
+        result.length = value;
+        return result;
+    }
+
+    /// @brief Leaf lengths in every unit, cycled through by the leaves.
+    const LayoutNode::Length LEAF_WIDTHS[] = {
+        length(0.5, LayoutNode::PERCENTAGE), length(120, LayoutNode::PIXEL), length(10, LayoutNode::VIEWPORT_WIDTH), length(4, LayoutNode::VIEWPORT_HEIGHT),
+    };
+    const LayoutNode::Length LEAF_HEIGHTS[] = {
+        length(24, LayoutNode::PIXEL), length(0.05, LayoutNode::PERCENTAGE), length(1, LayoutNode::VIEWPORT_WIDTH),
+    };
+
+    /// @brief A generated tree, nodes are kept in a single vector that is never resized (children point into it).
+    struct Tree {
+        std::vector<LayoutNode> nodes;
+
+        LayoutNode& root(){
+            return nodes[0];
+        }
+
+        LayoutNode& add(LayoutNode* parent){
+            nodes.emplace_back();
+            LayoutNode& node = nodes.back();
+            if(parent) parent->add_child(&node);
+            return node;
+        }
+    };
+
+    /// @brief Builds the tree, groups use the given layout mode (block stacks the leaves, flex wraps them into rows).
+    void build_tree(Tree& tree, LayoutNode::LayoutMode group_mode){
+        tree.nodes.reserve(NODE_COUNT);
+
+        LayoutNode& root = tree.add(nullptr);
+        root.width = length(100, LayoutNode::VIEWPORT_WIDTH);
+        root.height = length(100, LayoutNode::VIEWPORT_HEIGHT);
+        root.scroll_content = true;
+
+        size_t leaf = 0;
+        for (int section_index = 0; section_index < SECTION_COUNT; section_index++)
+        {
+            LayoutNode& section = tree.add(&root);
+            section.width = length(1, LayoutNode::PERCENTAGE);
+            section.height = length(2000, LayoutNode::PIXEL);
+            section.padding_up = length(4, LayoutNode::PIXEL);
+            section.padding_left = length(0.01, LayoutNode::PERCENTAGE);
+
+            for (int group_index = 0; group_index < GROUPS_PER_SECTION; group_index++)
+            {
+                LayoutNode& group = tree.add(&section);
+                group.width = length(1, LayoutNode::PERCENTAGE);
+                group.height = length(0.1, LayoutNode::PERCENTAGE);
+                group.margin_down = length(0.5, LayoutNode::VIEWPORT_HEIGHT);
+                group.layout_mode = group_mode;
+                group.flex_wrap = LayoutNode::FLEX_WRAP;
+                group.row_gap = length(2, LayoutNode::PIXEL);
+                group.column_gap = length(2, LayoutNode::PIXEL);
+
+                for (int leaf_index = 0; leaf_index < LEAVES_PER_GROUP; leaf_index++, leaf++)
+                {
+                    LayoutNode& node = tree.add(&group);
+                    node.width = LEAF_WIDTHS[leaf % 4];
+                    node.height = LEAF_HEIGHTS[leaf % 3];
+                    node.padding_up = length(2, LayoutNode::PIXEL);
+                    node.padding_left = length(0.01, LayoutNode::PERCENTAGE);
+                    node.margin_up = length(1, LayoutNode::PIXEL);
+                    node.flex_grow = leaf % 5 == 0 ? 1 : 0;
+                    if(leaf % 50 == 0){
+                        node.position_type = LayoutNode::ABSOLUTE;
+                        node.pos_x = length(0.5, LayoutNode::PERCENTAGE);
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief Reports a result of whole tree passes per laid out node.
+    benchmark::Result per_node(benchmark::Result result){
+        result.nsec_per_op /= NODE_COUNT;
+        result.ops_per_sec *= NODE_COUNT;
+        result.allocations_per_op /= NODE_COUNT;
+        return result;
+    }
+}
+
+void benchmark::run_layout(std::vector<Result>& results, double scale){
+    auto iterations = [scale](uint64_t count){
+        return (uint64_t)(count * scale) + 1;
+    };
+
+    const struct {
+        const char* name;
+        LayoutNode::LayoutMode mode;
+    } trees[] = {
+        {"block", LayoutNode::LAYOUT_BLOCK},
+        {"flex", LayoutNode::LAYOUT_FLEX},
+    };
+
+    for (const auto& tree_type : trees)
+    {
+        Tree tree;
+        build_tree(tree, tree_type.mode);
+        LayoutSolver::solve(tree.root(), VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+        std::string name = std::string("LayoutSolver::solve ") + tree_type.name + " 100k, cached geometry (per node)";
+        results.push_back(per_node(benchmark::run(name, iterations(30), [&tree](uint64_t){
+            LayoutSolver::solve(tree.root(), VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+            benchmark::keep(tree.root().overflow_y);
+        })));
+
+        // Every other pass has a different viewport width, so all geometry gets resolved again (window resizing).
+        name = std::string("LayoutSolver::solve ") + tree_type.name + " 100k, viewport resize (per node)";
+        results.push_back(per_node(benchmark::run(name, iterations(30), [&tree](uint64_t i){
+            LayoutSolver::solve(tree.root(), i % 2 ? VIEWPORT_WIDTH : VIEWPORT_WIDTH - 1, VIEWPORT_HEIGHT);
+            benchmark::keep(tree.root().overflow_y);
+        })));
+    }
+}
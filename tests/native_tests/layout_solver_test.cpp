@@ -0,0 +1,692 @@
+#include "test.h"
+#include "core/layout/layout_solver.h"
+
+/// Block layout, overflow and positioning of the LayoutSolver. Expected values are worked out by hand with the
+/// formulas ContainerBox used before the layout core was extracted (update_container_overflows, update_self_position
+/// and update_children_position of the baseline). Flex and grid cases follow the rules documented on LayoutNode.
+
+namespace {
+    constexpr double VIEWPORT_WIDTH = 1000;
+    constexpr double VIEWPORT_HEIGHT = 800;
+
+    LayoutNode::Length length(double value, LayoutNode::Unit unit){
+        LayoutNode::Length result;
+        result.unit_type = unit;
+        result.length = value;
+        return result;
+    }
+
+    LayoutNode::Length px(double value){
+        return length(value, LayoutNode::PIXEL);
+    }
+
+    /// @brief Percentages are stored as fractions, same as LengthPair (10% is 0.1)
+    LayoutNode::Length percent(double value){
+        return length(value / 100, LayoutNode::PERCENTAGE);
+    }
+}
+
+TEST_CASE(block_children_stack_vertically){
+    LayoutNode root;
+    root.width = percent(100);
+    root.height = length(50, LayoutNode::VIEWPORT_HEIGHT);
+    root.padding_up = px(10);
+    root.padding_left = px(20);
+
+    LayoutNode first;
+    first.width = percent(50);
+    first.height = px(100);
+    first.margin_up = px(5);
+    first.margin_left = px(7);
+    first.margin_down = px(3);
+    first.padding_up = px(2);
+    first.padding_down = px(4);
+
+    LayoutNode second;
+    second.width = length(10, LayoutNode::VIEWPORT_WIDTH);
+    second.height = percent(25);
+
+    root.add_child(&first);
+    root.add_child(&second);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    CHECK_EQUAL(root.geometry.width, 1000);
+    CHECK_EQUAL(root.geometry.height, 400);
+    CHECK_EQUAL(root.total_width, 1020);
+    CHECK_EQUAL(root.total_height, 410);
+    CHECK_EQUAL(root.position_x, 0);
+    CHECK_EQUAL(root.position_y, 0);
+
+    CHECK_EQUAL(first.geometry.width, 500);
+    CHECK_EQUAL(first.total_height, 106);
+    // Starts below the padding and the margin, containers don't get the left padding (only controls do).
+    CHECK_EQUAL(first.position_x, 7);
+    CHECK_EQUAL(first.position_y, 15);
+
+    CHECK_EQUAL(second.geometry.width, 100);
+    CHECK_EQUAL(second.geometry.height, 100);
+    // 15 + height 100 + margin down 3 + paddings 4 + 2
+    CHECK_EQUAL(second.position_x, 0);
+    CHECK_EQUAL(second.position_y, 124);
+
+    CHECK(!root.is_overflowed_x);
+    CHECK(!root.is_overflowed_y);
+    CHECK_EQUAL(root.overflow_y, 0);
+}
+
+TEST_CASE(block_hidden_children_take_no_space){
+    LayoutNode root;
+    root.width = px(100);
+    root.height = px(100);
+
+    LayoutNode hidden;
+    hidden.height = px(500);
+    hidden.hidden = true;
+
+    LayoutNode shown;
+    shown.height = px(20);
+
+    root.add_child(&hidden);
+    root.add_child(&shown);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    CHECK_EQUAL(shown.position_y, 0);
+    CHECK(!root.is_overflowed_y);
+}
+
+TEST_CASE(block_controls_get_left_padding_unless_anchored){
+    LayoutNode root;
+    root.width = px(300);
+    root.height = px(300);
+    root.padding_up = px(10);
+    root.padding_left = px(20);
+
+    LayoutNode control;
+    control.kind = LayoutNode::CONTROL;
+    control.height = px(30);
+
+    LayoutNode anchored;
+    anchored.kind = LayoutNode::CONTROL;
+    anchored.anchored = true;
+    anchored.height = px(15);
+
+    LayoutNode container;
+    container.height = px(10);
+    container.margin_left = px(4);
+
+    root.add_child(&control);
+    root.add_child(&anchored);
+    root.add_child(&container);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    CHECK_EQUAL(control.position_x, 20);
+    CHECK_EQUAL(control.position_y, 10);
+    CHECK_EQUAL(anchored.position_x, 0);
+    CHECK_EQUAL(anchored.position_y, 40);
+    CHECK_EQUAL(container.position_x, 4);
+    CHECK_EQUAL(container.position_y, 55);
+}
+
+TEST_CASE(overflow_of_stacked_and_positioned_children){
+    LayoutNode root;
+    root.width = px(200);
+    root.height = px(100);
+
+    LayoutNode first;
+    first.width = px(50);
+    first.height = px(80);
+
+    LayoutNode second;
+    second.width = px(50);
+    second.height = px(50);
+
+    LayoutNode absolute;
+    absolute.position_type = LayoutNode::ABSOLUTE;
+    absolute.width = px(100);
+    absolute.height = px(20);
+    absolute.pos_x = px(150);
+    absolute.margin_left = px(-10);
+
+    LayoutNode relative;
+    relative.position_type = LayoutNode::RELATIVE;
+    relative.width = px(10);
+    relative.height = px(10);
+    relative.pos_y = px(-30);
+
+    root.add_child(&first);
+    root.add_child(&second);
+    root.add_child(&absolute);
+    root.add_child(&relative);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // X: absolute child reaches 150 - 10 + 100 = 240, its negative margin counts as negative overflow on its own
+    CHECK(root.is_overflowed_x);
+    CHECK_EQUAL(root.negative_overflow_x, -10);
+    CHECK_EQUAL(root.overflow_x, 50);
+    // Y: stacked 80 + 50 + 10 (relative keeps its space) = 140, plus the relative child 30px above the top
+    CHECK(root.is_overflowed_y);
+    CHECK_EQUAL(root.negative_overflow_y, -30);
+    CHECK_EQUAL(root.overflow_y, 70);
+    CHECK_EQUAL(root.content_offset_x, 10);
+    CHECK_EQUAL(root.content_offset_y, 30);
+
+    // Not scrolled content, the offsets don't move the children.
+    CHECK_EQUAL(first.position_y, 0);
+    CHECK_EQUAL(second.position_y, 80);
+    CHECK_EQUAL(absolute.position_x, 140);
+    CHECK_EQUAL(absolute.position_y, 0);
+    CHECK_EQUAL(relative.position_x, 0);
+    CHECK_EQUAL(relative.position_y, 100);
+}
+
+TEST_CASE(overflow_offsets_scrolled_content){
+    LayoutNode root;
+    root.width = px(200);
+    root.height = px(100);
+    root.padding_up = px(10);
+    root.scroll_content = true;
+
+    LayoutNode child;
+    child.width = px(50);
+    child.height = px(150);
+    child.margin_up = px(-5);
+    child.margin_left = px(-8);
+
+    LayoutNode absolute;
+    absolute.position_type = LayoutNode::ABSOLUTE;
+    absolute.width = px(10);
+    absolute.height = px(10);
+    absolute.pos_x = px(5);
+
+    root.add_child(&child);
+    root.add_child(&absolute);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // Y: padding 10 + 150 - 5 = 155, 55 over the height plus 5 above the top
+    CHECK_EQUAL(root.negative_overflow_y, -5);
+    CHECK_EQUAL(root.overflow_y, 60);
+    CHECK_EQUAL(root.negative_overflow_x, -8);
+    CHECK_EQUAL(root.overflow_x, 8);
+
+    // Scrolled content starts at the content offset instead of the padding.
+    CHECK_EQUAL(child.position_x, 0);
+    CHECK_EQUAL(child.position_y, 0);
+    CHECK_EQUAL(absolute.position_x, 5);
+    CHECK_EQUAL(absolute.position_y, 0);
+}
+
+TEST_CASE(self_position_of_positioned_root){
+    LayoutNode root;
+    root.position_type = LayoutNode::ABSOLUTE;
+    root.width = px(10);
+    root.height = px(10);
+    root.margin_left = px(5);
+    root.margin_up = px(6);
+    root.pos_x = percent(10);
+    root.pos_y = length(5, LayoutNode::VIEWPORT_HEIGHT);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    CHECK_EQUAL(root.position_x, 105);
+    CHECK_EQUAL(root.position_y, 46);
+
+    // Static roots ignore pos_x and pos_y.
+    root.position_type = LayoutNode::STATIC;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(root.position_x, 5);
+    CHECK_EQUAL(root.position_y, 6);
+}
+
+TEST_CASE(nested_percentages_resolve_against_parent){
+    LayoutNode root;
+    root.width = px(400);
+    root.height = px(200);
+
+    LayoutNode child;
+    child.width = percent(50);
+    child.height = percent(50);
+    child.padding_left = percent(10);
+    child.margin_up = percent(10);
+
+    LayoutNode grandchild;
+    grandchild.width = percent(50);
+    grandchild.height = length(10, LayoutNode::VIEWPORT_WIDTH);
+
+    root.add_child(&child);
+    child.add_child(&grandchild);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    CHECK_EQUAL(child.geometry.width, 200);
+    CHECK_EQUAL(child.geometry.height, 100);
+    CHECK_EQUAL(child.geometry.padding_left, 40);
+    // Vertical margins are % of the parent height.
+    CHECK_EQUAL(child.geometry.margin_up, 20);
+    CHECK_EQUAL(child.total_width, 240);
+    CHECK_EQUAL(grandchild.geometry.width, 100);
+    CHECK_EQUAL(grandchild.geometry.height, 100);
+}
+
+TEST_CASE(geometry_cache_follows_viewport){
+    LayoutNode root;
+    root.width = length(50, LayoutNode::VIEWPORT_WIDTH);
+    root.height = px(10);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(root.geometry.width, 500);
+
+    CHECK(!LayoutSolver::update_geometry(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT, VIEWPORT_WIDTH, VIEWPORT_HEIGHT));
+    LayoutSolver::solve(root, 1200, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(root.geometry.width, 600);
+
+    root.width = px(30);
+    root.geometry_dirty = true;
+    LayoutSolver::solve(root, 1200, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(root.geometry.width, 30);
+}
+
+TEST_CASE(unknown_units_resolve_to_zero){
+    LayoutNode root;
+    root.width = LayoutNode::Length();
+    root.height = length(3, LayoutNode::FRACTION);
+    root.padding_up = px(-0.0);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    CHECK_EQUAL(root.geometry.width, 0);
+    CHECK_EQUAL(root.geometry.height, 0);
+    CHECK_EQUAL(root.total_height, 0);
+}
+
+TEST_CASE(flex_wrap_breaks_lines_and_stretches_to_line){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_FLEX;
+    root.flex_wrap = LayoutNode::FLEX_WRAP;
+    root.width = px(100);
+    root.height = px(100);
+    root.padding_up = px(8);
+    root.column_gap = px(10);
+    root.row_gap = px(5);
+
+    LayoutNode first;
+    first.width = px(40);
+    first.height = px(20);
+    LayoutNode second;
+    second.width = px(40);
+    second.height = px(30);
+    LayoutNode third;
+    third.width = px(40);
+    third.height = px(10);
+    // No height, stretched to the height of its line.
+    LayoutNode fourth;
+    fourth.width = px(40);
+
+    root.add_child(&first);
+    root.add_child(&second);
+    root.add_child(&third);
+    root.add_child(&fourth);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // 40 + 10 + 40 fits, the third item would need 140 and starts a line below the tallest (30) plus the row gap.
+    CHECK_EQUAL(first.position_x, 0);
+    CHECK_EQUAL(first.position_y, 8);
+    CHECK_EQUAL(second.position_x, 50);
+    CHECK_EQUAL(second.position_y, 8);
+    CHECK_EQUAL(third.position_x, 0);
+    CHECK_EQUAL(third.position_y, 43);
+    CHECK_EQUAL(fourth.position_x, 50);
+    CHECK_EQUAL(fourth.position_y, 43);
+    CHECK_EQUAL(fourth.geometry.height, 10);
+    CHECK(!root.is_overflowed_y);
+
+    // Without wrapping everything stays on one line and shrinks, 160 into 100.
+    root.flex_wrap = LayoutNode::FLEX_NO_WRAP;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(first.geometry.width, 17.5);
+    CHECK_EQUAL(fourth.position_x, 82.5);
+    CHECK_EQUAL(fourth.position_y, 8);
+    // Single line spans the whole cross size.
+    CHECK_EQUAL(fourth.geometry.height, 100);
+}
+
+TEST_CASE(flex_justify_content_distributes_free_space){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_FLEX;
+    root.width = px(100);
+    root.height = px(50);
+
+    LayoutNode first;
+    first.width = px(20);
+    first.height = px(10);
+    LayoutNode second;
+    second.width = px(20);
+    second.height = px(10);
+
+    root.add_child(&first);
+    root.add_child(&second);
+
+    const struct {
+        LayoutNode::FlexJustify justify;
+        double first_x;
+        double second_x;
+    } cases[] = {
+        {LayoutNode::JUSTIFY_START, 0, 20},
+        {LayoutNode::JUSTIFY_END, 60, 80},
+        {LayoutNode::JUSTIFY_CENTER, 30, 50},
+        {LayoutNode::JUSTIFY_SPACE_BETWEEN, 0, 80},
+        {LayoutNode::JUSTIFY_SPACE_AROUND, 15, 65},
+        {LayoutNode::JUSTIFY_SPACE_EVENLY, 20, 60},
+    };
+    for (const auto& test : cases)
+    {
+        root.justify_content = test.justify;
+        LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+        CHECK_EQUAL(first.position_x, test.first_x);
+        CHECK_EQUAL(second.position_x, test.second_x);
+    }
+}
+
+TEST_CASE(flex_align_items_and_stretch){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_FLEX;
+    root.width = px(100);
+    root.height = px(100);
+
+    LayoutNode sized;
+    sized.width = px(20);
+    sized.height = px(10);
+    // No height, only this one gets stretched.
+    LayoutNode unsized;
+    unsized.width = px(20);
+    unsized.margin_up = px(4);
+    unsized.margin_down = px(6);
+    unsized.padding_up = px(2);
+
+    root.add_child(&sized);
+    root.add_child(&unsized);
+
+    root.align_items = LayoutNode::ALIGN_STRETCH;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(sized.position_y, 0);
+    CHECK_EQUAL(sized.geometry.height, 10);
+    // 100 - margins 10 - padding 2
+    CHECK_EQUAL(unsized.position_y, 4);
+    CHECK_EQUAL(unsized.geometry.height, 88);
+
+    root.align_items = LayoutNode::ALIGN_START;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(sized.position_y, 0);
+    CHECK_EQUAL(unsized.position_y, 4);
+    CHECK_EQUAL(unsized.geometry.height, 0);
+
+    root.align_items = LayoutNode::ALIGN_END;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(sized.position_y, 90);
+    // Outer size 4 + 2 + 6
+    CHECK_EQUAL(unsized.position_y, 92);
+
+    root.align_items = LayoutNode::ALIGN_CENTER;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(sized.position_y, 45);
+    CHECK_EQUAL(unsized.position_y, 48);
+}
+
+TEST_CASE(flex_grow_and_shrink_distribution){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_FLEX;
+    root.width = px(100);
+    root.height = px(10);
+
+    LayoutNode first;
+    first.width = px(20);
+    first.flex_grow = 1;
+    LayoutNode second;
+    second.width = px(20);
+    second.flex_grow = 3;
+    LayoutNode fixed;
+    fixed.width = px(20);
+    // Controls keep their size.
+    LayoutNode control;
+    control.kind = LayoutNode::CONTROL;
+    control.flex_grow = 5;
+
+    root.add_child(&first);
+    root.add_child(&second);
+    root.add_child(&fixed);
+    root.add_child(&control);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // 40 free, split 1:3
+    CHECK_EQUAL(first.geometry.width, 30);
+    CHECK_EQUAL(second.geometry.width, 50);
+    CHECK_EQUAL(fixed.geometry.width, 20);
+    CHECK_EQUAL(second.position_x, 30);
+    CHECK_EQUAL(fixed.position_x, 80);
+    CHECK_EQUAL(control.position_x, 100);
+
+    // 20 missing, shrink is weighted by the basis: 60 * 1 and 60 * 3
+    LayoutNode shrink_root;
+    shrink_root.layout_mode = LayoutNode::LAYOUT_FLEX;
+    shrink_root.width = px(100);
+    shrink_root.height = px(10);
+
+    LayoutNode light;
+    light.width = px(60);
+    LayoutNode heavy;
+    heavy.width = px(60);
+    heavy.flex_shrink = 3;
+    // Can't shrink below its padding.
+    LayoutNode padded;
+    padded.width = px(10);
+    padded.padding_left = px(5);
+    padded.flex_shrink = 100;
+
+    shrink_root.add_child(&light);
+    shrink_root.add_child(&heavy);
+    LayoutSolver::solve(shrink_root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(light.geometry.width, 55);
+    CHECK_EQUAL(heavy.geometry.width, 45);
+    CHECK_EQUAL(heavy.position_x, 55);
+    CHECK(!shrink_root.is_overflowed_x);
+
+    shrink_root.add_child(&padded);
+    LayoutSolver::solve(shrink_root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(padded.geometry.width, 0);
+    CHECK_EQUAL(padded.total_width, 5);
+}
+
+TEST_CASE(flex_reverse_directions){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_FLEX;
+    root.flex_direction = LayoutNode::FLEX_ROW_REVERSE;
+    root.width = px(100);
+    root.height = px(50);
+
+    LayoutNode first;
+    first.width = px(20);
+    first.height = px(10);
+    first.margin_left = px(5);
+    LayoutNode second;
+    second.width = px(30);
+    second.height = px(20);
+
+    root.add_child(&first);
+    root.add_child(&second);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // Flows from the right, the left margin of the first item separates it from the second one.
+    CHECK_EQUAL(first.position_x, 80);
+    CHECK_EQUAL(second.position_x, 45);
+
+    root.flex_direction = LayoutNode::FLEX_COLUMN_REVERSE;
+    root.row_gap = px(5);
+    root.align_items = LayoutNode::ALIGN_START;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    CHECK_EQUAL(first.position_x, 5);
+    CHECK_EQUAL(first.position_y, 40);
+    CHECK_EQUAL(second.position_x, 0);
+    CHECK_EQUAL(second.position_y, 15);
+}
+
+TEST_CASE(flex_basis_overrides_main_size){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_FLEX;
+    root.width = px(200);
+    root.height = px(100);
+
+    LayoutNode percent_basis;
+    percent_basis.width = px(10);
+    percent_basis.flex_basis = percent(50);
+    LayoutNode pixel_basis;
+    pixel_basis.width = px(999);
+    pixel_basis.flex_basis = px(20);
+    pixel_basis.flex_grow = 1;
+
+    root.add_child(&percent_basis);
+    root.add_child(&pixel_basis);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // Basis is % of the container main size, the free 80 goes to the growing item.
+    CHECK_EQUAL(percent_basis.geometry.width, 100);
+    CHECK_EQUAL(pixel_basis.geometry.width, 100);
+    CHECK_EQUAL(pixel_basis.position_x, 100);
+
+    // In a column the basis is the height, % of the container height.
+    root.flex_direction = LayoutNode::FLEX_COLUMN;
+    pixel_basis.flex_grow = 0;
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    CHECK_EQUAL(percent_basis.geometry.height, 50);
+    CHECK_EQUAL(pixel_basis.geometry.height, 20);
+    CHECK_EQUAL(pixel_basis.position_y, 50);
+}
+
+TEST_CASE(grid_fraction_tracks_share_free_space){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_GRID;
+    root.width = px(100);
+    root.height = px(50);
+    root.column_gap = px(20);
+    root.grid_columns = {length(1, LayoutNode::FRACTION), length(3, LayoutNode::FRACTION)};
+
+    LayoutNode first;
+    first.height = px(10);
+    LayoutNode second;
+    second.height = px(10);
+
+    root.add_child(&first);
+    root.add_child(&second);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // 100 - gap 20 split 1:3, cells without a width fill their column.
+    CHECK_EQUAL(first.position_x, 0);
+    CHECK_EQUAL(first.geometry.width, 20);
+    CHECK_EQUAL(second.position_x, 40);
+    CHECK_EQUAL(second.geometry.width, 60);
+    CHECK_EQUAL(second.position_y, 0);
+}
+
+TEST_CASE(grid_auto_tracks_fit_largest_cell){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_GRID;
+    root.width = px(200);
+    root.height = px(100);
+    root.padding_up = px(3);
+    root.row_gap = px(4);
+    root.grid_columns = {LayoutNode::Length(), length(1, LayoutNode::FRACTION)};
+
+    LayoutNode cells[4];
+    cells[0].width = px(30);
+    cells[0].height = px(10);
+    cells[1].height = px(20);
+    cells[2].width = px(40);
+    cells[2].margin_left = px(10);
+    cells[2].height = px(5);
+    cells[3].height = px(2);
+    cells[3].padding_down = px(3);
+    for (LayoutNode& cell : cells)
+    {
+        root.add_child(&cell);
+    }
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // Auto column fits the widest outer width (40 + margin 10), the fraction column takes the rest.
+    CHECK_EQUAL(cells[1].position_x, 50);
+    CHECK_EQUAL(cells[1].geometry.width, 150);
+    CHECK_EQUAL(cells[2].position_x, 10);
+    // Implicit rows fit the tallest cell of the row: 20 and 5, starting below the padding.
+    CHECK_EQUAL(cells[0].position_y, 3);
+    CHECK_EQUAL(cells[2].position_y, 27);
+    CHECK_EQUAL(cells[3].position_y, 27);
+    // Cells with a width keep it.
+    CHECK_EQUAL(cells[0].geometry.width, 30);
+}
+
+TEST_CASE(grid_percentage_tracks_and_gaps){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_GRID;
+    root.width = px(200);
+    root.height = px(100);
+    root.column_gap = percent(5);
+    root.row_gap = px(6);
+    root.grid_columns = {percent(25), percent(50)};
+    root.grid_rows = {percent(50), px(12)};
+
+    LayoutNode cells[4];
+    for (LayoutNode& cell : cells)
+    {
+        root.add_child(&cell);
+    }
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // Columns 50 and 100 with a 10 gap, rows 50 and 12 with a 6 gap.
+    CHECK_EQUAL(cells[0].geometry.width, 50);
+    CHECK_EQUAL(cells[1].position_x, 60);
+    CHECK_EQUAL(cells[1].geometry.width, 100);
+    CHECK_EQUAL(cells[0].geometry.height, 50);
+    CHECK_EQUAL(cells[2].position_y, 56);
+    CHECK_EQUAL(cells[3].geometry.height, 12);
+}
+
+TEST_CASE(grid_implicit_rows_and_stretch){
+    LayoutNode root;
+    root.layout_mode = LayoutNode::LAYOUT_GRID;
+    root.width = px(100);
+    root.height = px(100);
+    root.grid_columns = {px(50), px(50)};
+    root.grid_rows = {px(40)};
+
+    LayoutNode stretched;
+    stretched.margin_up = px(5);
+    stretched.margin_left = px(3);
+    stretched.padding_left = px(2);
+    stretched.padding_down = px(4);
+    LayoutNode sized;
+    sized.width = px(20);
+    sized.height = px(15);
+    LayoutNode implicit;
+    implicit.height = px(25);
+    LayoutNode implicit_stretched;
+    // Controls are positioned but never resized.
+    LayoutNode control;
+    control.kind = LayoutNode::CONTROL;
+
+    root.add_child(&stretched);
+    root.add_child(&sized);
+    root.add_child(&implicit);
+    root.add_child(&implicit_stretched);
+    root.add_child(&control);
+    LayoutSolver::solve(root, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // Stretched to the cell minus margins and paddings.
+    CHECK_EQUAL(stretched.position_x, 3);
+    CHECK_EQUAL(stretched.position_y, 5);
+    CHECK_EQUAL(stretched.geometry.width, 45);
+    CHECK_EQUAL(stretched.geometry.height, 31);
+    CHECK_EQUAL(sized.geometry.width, 20);
+    CHECK_EQUAL(sized.geometry.height, 15);
+
+    // Two implicit auto rows, 25 tall and empty.
+    CHECK_EQUAL(implicit.position_y, 40);
+    CHECK_EQUAL(implicit_stretched.position_x, 50);
+    CHECK_EQUAL(implicit_stretched.geometry.height, 25);
+    CHECK_EQUAL(control.position_x, 0);
+    CHECK_EQUAL(control.position_y, 65);
+    CHECK_EQUAL(control.geometry.width, 0);
+}
@@ -0,0 +1,269 @@
+#include "test.h"
+#include "commons/length_parser.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+
+/// LengthParser has to give bit for bit the results of the String based parser it replaced. The reference below is
+/// that parser on std::u32string: replace(" ", ""), get_string_number(readable_chars, implied_zero), the unit suffix
+/// compared like LengthPair::get_unit, and Godot's String::to_float (built_in_strtod of Godot 4.3).
+
+namespace {
+    double reference_strtod(const char32_t* string){
+        static const int MAX_EXPONENT = 511;
+        static const double POWERS_OF_10[] = {10., 100., 1.0e4, 1.0e8, 1.0e16, 1.0e32, 1.0e64, 1.0e128, 1.0e256};
+
+        const char32_t* p = string;
+        bool sign = false;
+        if(*p == '-'){
+            sign = true;
+            p++;
+        }else if(*p == '+'){
+            p++;
+        }
+
+        int decimal_point = -1;
+        int mantissa_size = 0;
+        for (;; mantissa_size++)
+        {
+            char32_t c = *p;
+            if(!(c >= '0' && c <= '9')){
+                if(c != '.' || decimal_point >= 0) break;
+                decimal_point = mantissa_size;
+            }
+            p++;
+        }
+
+        p -= mantissa_size;
+        if(decimal_point < 0){
+            decimal_point = mantissa_size;
+        }else{
+            mantissa_size -= 1;
+        }
+        int fraction_exponent;
+        if(mantissa_size > 18){
+            fraction_exponent = decimal_point - 18;
+            mantissa_size = 18;
+        }else{
+            fraction_exponent = decimal_point - mantissa_size;
+        }
+
+        double fraction = 0;
+        if(mantissa_size > 0){
+            int first = 0;
+            int second = 0;
+            for (; mantissa_size > 9; mantissa_size--)
+            {
+                char32_t c = *p++;
+                if(c == '.') c = *p++;
+                first = 10 * first + (c - '0');
+            }
+            for (; mantissa_size > 0; mantissa_size--)
+            {
+                char32_t c = *p++;
+                if(c == '.') c = *p++;
+                second = 10 * second + (c - '0');
+            }
+            fraction = (1.0e9 * first) + second;
+
+            int exponent = fraction_exponent;
+            bool exponent_sign = exponent < 0;
+            if(exponent_sign) exponent = -exponent;
+            if(exponent > MAX_EXPONENT) exponent = MAX_EXPONENT;
+            double power = 1.0;
+            for (const double* d = POWERS_OF_10; exponent != 0; exponent >>= 1, d++)
+            {
+                if(exponent & 1) power *= *d;
+            }
+            fraction = exponent_sign ? fraction / power : fraction * power;
+        }
+        return sign ? -fraction : fraction;
+    }
+
+    std::u32string reference_string_number(const std::u32string& str, int& stopped_at){
+        std::u32string number;
+        bool dot_used = false;
+        stopped_at = 0;
+        for (int i = 0; i < (int)str.size(); i++)
+        {
+            char32_t c = str[i];
+            if(i == 0 && c == '-'){
+                number += '-';
+                continue;
+            }else if(i == 0 && c == '+') continue;
+
+            if(c == '\'') continue;
+            if(c == '.'){
+                if(dot_used) continue;
+                if(i - 1 >= 0 && str[i - 1] != '-'){
+                    number += c;
+                }else{
+                    number += U"0.";
+                }
+                dot_used = true;
+                continue;
+            }
+
+            if(c >= '0' && c <= '9'){
+                number += c;
+            }else{
+                stopped_at = i;
+                break;
+            }
+            stopped_at = i;
+        }
+        return number;
+    }
+
+    LengthParser::Result reference_parse(const std::u32string& string){
+        std::u32string stripped;
+        for (char32_t c : string)
+        {
+            if(c != ' ') stripped += c;
+        }
+
+        int stopped_at = 0;
+        std::u32string number = reference_string_number(stripped, stopped_at);
+        std::u32string unit = stripped.substr(std::min((size_t)stopped_at, stripped.size()));
+
+        LengthParser::Result result;
+        result.length = number.empty() ? 0 : reference_strtod(number.c_str());
+        if(unit == U"px") result.unit = LengthParser::PIXEL;
+        else if(unit == U"%") result.unit = LengthParser::PERCENTAGE;
+        else if(unit == U"vh") result.unit = LengthParser::VIEWPORT_HEIGHT;
+        else if(unit == U"vw") result.unit = LengthParser::VIEWPORT_WIDTH;
+        else if(unit == U"fr") result.unit = LengthParser::FRACTION;
+        if(result.unit == LengthParser::PERCENTAGE) result.length = result.length / 100;
+        return result;
+    }
+
+    uint64_t get_bits(double value){
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    std::u32string to_u32(const char* string){
+        std::u32string result;
+        for (; *string; string++)
+        {
+            result += (char32_t)*string;
+        }
+        return result;
+    }
+
+    LengthParser::Status parse(const std::u32string& string, LengthParser::Result& result){
+        return LengthParser::parse(string.data(), (int64_t)string.size(), result);
+    }
+
+    /// @brief Compares the parser with the reference, prints the string on a mismatch.
+    bool matches_reference(const std::u32string& string){
+        LengthParser::Result expected = reference_parse(string);
+        LengthParser::Result result;
+        parse(string, result);
+        if(result.unit == expected.unit && get_bits(result.length) == get_bits(expected.length)) return true;
+
+        std::string printable(string.begin(), string.end());
+        std::printf("  \"%s\": (%d, %.17g), expected (%d, %.17g)\n", printable.c_str(), result.unit, result.length, expected.unit, expected.length);
+        return false;
+    }
+}
+
+TEST_CASE(length_parser_table){
+    const struct {
+        const char* string;
+        int unit;
+        double length;
+        LengthParser::Status status;
+    } cases[] = {
+        {"10px", LengthParser::PIXEL, 10, LengthParser::PARSE_OK},
+        {"50%", LengthParser::PERCENTAGE, 0.5, LengthParser::PARSE_OK},
+        {"1'000.5vw", LengthParser::VIEWPORT_WIDTH, 1000.5, LengthParser::PARSE_OK},
+        {" 12 . 5 p x ", LengthParser::PIXEL, 12.5, LengthParser::PARSE_OK},
+        {"4vh", LengthParser::VIEWPORT_HEIGHT, 4, LengthParser::PARSE_OK},
+        {"1fr", LengthParser::FRACTION, 1, LengthParser::PARSE_OK},
+        {".45px", LengthParser::PIXEL, 0.45, LengthParser::PARSE_OK},
+        {"-.5vw", LengthParser::VIEWPORT_WIDTH, -0.5, LengthParser::PARSE_OK},
+        {"+8px", LengthParser::PIXEL, 8, LengthParser::PARSE_OK},
+        {"1.2.3px", LengthParser::PIXEL, 1.23, LengthParser::PARSE_OK},
+        {"", LengthParser::NOT_SET, 0, LengthParser::PARSE_EMPTY},
+        {"   ", LengthParser::NOT_SET, 0, LengthParser::PARSE_EMPTY},
+        {"10", LengthParser::NOT_SET, 10, LengthParser::PARSE_NO_UNIT},
+        {"10em", LengthParser::NOT_SET, 10, LengthParser::PARSE_UNKNOWN_UNIT},
+        {"10pxx", LengthParser::NOT_SET, 10, LengthParser::PARSE_UNKNOWN_UNIT},
+        {"5-px", LengthParser::NOT_SET, 5, LengthParser::PARSE_UNKNOWN_UNIT},
+        {"1e3px", LengthParser::NOT_SET, 1, LengthParser::PARSE_UNKNOWN_UNIT},
+        // Without a number the unit is kept, the length is 0.
+        {"px", LengthParser::PIXEL, 0, LengthParser::PARSE_NO_NUMBER},
+        {"-%", LengthParser::PERCENTAGE, -0.0, LengthParser::PARSE_NO_NUMBER},
+        {".", LengthParser::NOT_SET, 0, LengthParser::PARSE_NO_NUMBER},
+    };
+
+    for (const auto& test : cases)
+    {
+        std::u32string string = to_u32(test.string);
+        LengthParser::Result result;
+        LengthParser::Status status = parse(string, result);
+        if(status != test.status || result.unit != test.unit || get_bits(result.length) != get_bits(test.length)){
+            std::printf("  \"%s\": status %d (%d, %.17g), expected status %d (%d, %.17g)\n", test.string, status, result.unit,
+                result.length, test.status, test.unit, test.length);
+            CHECK(false);
+        }
+        CHECK(matches_reference(string));
+    }
+}
+
+TEST_CASE(length_parser_long_and_extreme_numbers){
+    const char* cases[] = {
+        "123456789012345678901234px",
+        "0.000000000000000000000000123%",
+        "99999999999999999999.9999999999px",
+        "3.14159265358979323846vh",
+        "0.1px", "0.3px", "2.675vw", "1'000'000'000'000'000'000'000'000px",
+        "0.00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001px",
+        "-'.5px", "'.5px", "+.5%",
+    };
+    for (const char* test : cases)
+    {
+        CHECK(matches_reference(to_u32(test)));
+    }
+}
+
+TEST_CASE(length_parser_matches_reference_on_generated_strings){
+    // Fixed seed, every run checks the same strings.
+    std::mt19937_64 random(42);
+    const char alphabet[] = " 0123456789.'-+pxvwhf%re5";
+    const char* units[] = {"px", "%", "vw", "vh", "fr", ""};
+    int mismatches {0};
+
+    // Random characters, mostly invalid strings.
+    for (int i = 0; i < 300000; i++)
+    {
+        std::u32string string;
+        int length = random() % 14;
+        for (int c = 0; c < length; c++)
+        {
+            string += (char32_t)alphabet[random() % (sizeof(alphabet) - 1)];
+        }
+        if(!matches_reference(string) && ++mismatches > 10) break;
+    }
+
+    // Numbers of up to 30 digits with readable chars and spaces, followed by a unit.
+    for (int i = 0; i < 300000; i++)
+    {
+        std::u32string string;
+        if(random() % 4 == 0) string += U'-';
+        int digits = random() % 30;
+        for (int c = 0; c < digits; c++)
+        {
+            int kind = random() % 14;
+            string += kind == 10 ? U'.' : kind == 11 ? U'\'' : kind == 12 ? U' ' : (char32_t)('0' + random() % 10);
+        }
+        string += to_u32(units[random() % 6]);
+        if(!matches_reference(string) && ++mismatches > 10) break;
+    }
+
+    CHECK(mismatches == 0);
+}
@@ -0,0 +1,170 @@
+#include "test.h"
+#include "core/layout/spatial_index.h"
+#include <random>
+
+/// Picking of the SpatialIndex: deepest container, scrollbar regions, scrolled scopes and large indices against a linear scan.
+
+namespace {
+    SpatialIndex::Entry entry(int id, int depth, double x, double y, double width, double height){
+        SpatialIndex::Entry result;
+        result.id = id;
+        result.depth = depth;
+        result.rect = SpatialIndex::Rect{x, y, width, height};
+        return result;
+    }
+
+    /// @brief Scrollable 100x100 container at the origin, with a 10px vertical scrollbar on the right and a horizontal one at the bottom.
+    SpatialIndex::Entry scrollable_entry(int id, int content_scope){
+        SpatialIndex::Entry result = entry(id, 0, 0, 0, 100, 100);
+        result.scrollable = true;
+        result.vertical_scrollbar = SpatialIndex::Rect{90, 0, 10, 90};
+        result.horizontal_scrollbar = SpatialIndex::Rect{0, 90, 90, 10};
+        result.content_scope = content_scope;
+        return result;
+    }
+}
+
+TEST_CASE(spatial_index_deepest_container_wins){
+    SpatialIndex index;
+    index.clear();
+    index.add_entry(0, entry(1, 0, 0, 0, 100, 100));
+    index.add_entry(0, entry(2, 1, 10, 10, 50, 50));
+    index.add_entry(0, entry(3, 1, 30, 30, 50, 50));
+    // Deeper, but without any area.
+    index.add_entry(0, entry(4, 5, 0, 0, 0, 100));
+    index.build();
+
+    CHECK(index.size() == 4);
+    CHECK(index.query(90, 90).id == 1);
+    CHECK(index.query(15, 15).id == 2);
+    // Same depth, the later entry wins.
+    CHECK(index.query(40, 40).id == 3);
+    CHECK(index.query(0, 50).id == 1);
+    // Right and bottom edges are outside.
+    CHECK(index.query(100, 50).id == -1);
+    CHECK(index.query(-1, 50).id == -1);
+
+    SpatialIndex::Hit hit = index.query(40, 40);
+    CHECK(hit.scrollable_id == -1);
+    CHECK(hit.region == SpatialIndex::REGION_NONE);
+}
+
+TEST_CASE(spatial_index_scrollbars_beat_content){
+    SpatialIndex index;
+    index.clear();
+    int content = index.add_scope();
+    index.add_entry(0, scrollable_entry(1, content));
+    // Wider than the container, it's under the scrollbars too.
+    index.add_entry(content, entry(2, 1, 0, 0, 200, 200));
+    index.build();
+
+    SpatialIndex::Hit hit = index.query(95, 50);
+    CHECK(hit.id == 1);
+    CHECK(hit.scrollable_id == 1);
+    CHECK(hit.region == SpatialIndex::REGION_VERTICAL_SCROLLBAR);
+
+    hit = index.query(50, 95);
+    CHECK(hit.id == 1);
+    CHECK(hit.region == SpatialIndex::REGION_HORIZONTAL_SCROLLBAR);
+
+    hit = index.query(50, 50);
+    CHECK(hit.id == 2);
+    CHECK(hit.scrollable_id == 1);
+    CHECK(hit.region == SpatialIndex::REGION_CONTENT);
+}
+
+TEST_CASE(spatial_index_horizontal_scrollbar_band){
+    SpatialIndex index;
+    index.clear();
+    int content = index.add_scope();
+    SpatialIndex::Entry container = scrollable_entry(1, content);
+    container.horizontal_scrollbar_band = 5;
+    index.add_entry(0, container);
+    index.add_entry(content, entry(2, 1, 0, 0, 100, 100));
+    index.build();
+
+    // Within 5px above the scrollbar the content is still picked, but the region is the scrollbar.
+    SpatialIndex::Hit hit = index.query(50, 87);
+    CHECK(hit.id == 2);
+    CHECK(hit.scrollable_id == 1);
+    CHECK(hit.region == SpatialIndex::REGION_HORIZONTAL_SCROLLBAR);
+
+    CHECK(index.query(50, 84).region == SpatialIndex::REGION_CONTENT);
+    // The band is as wide as the scrollbar, not the vertical scrollbar column.
+    CHECK(index.query(92, 87).region == SpatialIndex::REGION_VERTICAL_SCROLLBAR);
+}
+
+TEST_CASE(spatial_index_scope_origins_follow_scroll){
+    SpatialIndex index;
+    index.clear();
+    int content = index.add_scope();
+    int nested_content = index.add_scope();
+    index.add_entry(0, scrollable_entry(1, content));
+    index.add_entry(content, entry(2, 1, 0, 0, 80, 40));
+    SpatialIndex::Entry nested = entry(3, 1, 0, 40, 80, 100);
+    nested.scrollable = true;
+    nested.content_scope = nested_content;
+    index.add_entry(content, nested);
+    index.add_entry(nested_content, entry(4, 2, 0, 0, 80, 30));
+    index.add_entry(nested_content, entry(5, 2, 0, 30, 80, 30));
+    index.build();
+    // Content scopes start where their container does, their origin includes the scroll.
+    index.set_scope_origin(nested_content, 0, 40);
+
+    CHECK(index.query(10, 10).id == 2);
+    SpatialIndex::Hit hit = index.query(10, 50);
+    CHECK(hit.id == 4);
+    CHECK(hit.scrollable_id == 3);
+
+    // Scrolled by 30, no rebuild.
+    index.set_scope_origin(content, 0, -30);
+    CHECK(index.query(10, 5).id == 2);
+    CHECK(index.query(10, 15).id == 4);
+    index.set_scope_origin(nested_content, 0, 10);
+    CHECK(index.query(10, 15).id == 5);
+    CHECK(index.query(10, 15).scrollable_id == 3);
+
+    // Out of range scopes are ignored.
+    index.set_scope_origin(7, 1000, 1000);
+    index.set_scope_origin(-1, 1000, 1000);
+    CHECK(index.query(10, 15).id == 5);
+}
+
+TEST_CASE(spatial_index_large_inputs_match_linear_scan){
+    // Median splits keep the hierarchy log2(n / 4) deep, so the traversal stack (MAX_STACK) never overflows and
+    // its linear fallback can't be reached. Large indices still have to give exactly the results of a linear scan.
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> position(0, 10000);
+    std::uniform_real_distribution<double> extent(0, 400);
+
+    const int entry_count = 100000;
+    std::vector<SpatialIndex::Entry> entries;
+    entries.reserve(entry_count);
+    SpatialIndex index;
+    index.clear();
+    for (int i = 0; i < entry_count; i++)
+    {
+        // Every 1000th entry covers most of the space, deep stacks of overlapping rects.
+        bool large = i % 1000 == 0;
+        entries.push_back(entry(i, random() % 8, position(random) / (large ? 10 : 1), position(random) / (large ? 10 : 1),
+            large ? 9000 : extent(random), large ? 9000 : extent(random)));
+        index.add_entry(0, entries.back());
+    }
+    index.build();
+    CHECK(index.size() == (size_t)entry_count);
+
+    int mismatches {0};
+    for (int query = 0; query < 500; query++)
+    {
+        double x = position(random);
+        double y = position(random);
+        int expected = -1;
+        for (int i = 0; i < entry_count; i++)
+        {
+            if(!entries[i].rect.has_point(x, y)) continue;
+            if(expected < 0 || entries[i].depth >= entries[expected].depth) expected = i;
+        }
+        if(index.query(x, y).id != expected) mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
@@ -0,0 +1,48 @@
+#include "test.h"
+
+namespace {
+    int failed_checks {0};
+}
+
+std::vector<test::Case>& test::get_cases(){
+    static std::vector<Case> cases;
+    return cases;
+}
+
+test::Registration::Registration(const char* name, void (*function)()){
+    get_cases().push_back({name, function});
+}
+
+void test::fail(const char* file, int line, const char* message){
+    failed_checks++;
+    std::printf("  %s:%d: failed: %s\n", file, line, message);
+}
+
+void test::fail_equal(const char* file, int line, const char* expression, double actual, double expected){
+    failed_checks++;
+    std::printf("  %s:%d: failed: %s is %.17g, expected %.17g\n", file, line, expression, actual, expected);
+}
+
+int main(int argc, char** argv){
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int ran {0};
+    int failed {0};
+
+    for (const test::Case& test_case : test::get_cases())
+    {
+        if(filter != nullptr && std::strstr(test_case.name, filter) == nullptr) continue;
+
+        int failed_before = failed_checks;
+        test_case.function();
+        ran++;
+        if(failed_checks != failed_before){
+            failed++;
+            std::printf("FAIL %s\n", test_case.name);
+        }else{
+            std::printf("ok   %s\n", test_case.name);
+        }
+    }
+
+    std::printf("\n%d of %d test cases passed\n", ran - failed, ran);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/// @brief Minimal harness of the native unit tests, test cases register themselves and run from test.cpp
+///
+/// Build and run with: scons tests && ./build/harmonia_tests [filter]
+namespace test {
+
+    struct Case {
+        const char* name;
+        void (*function)();
+    };
+
+    /// @brief All registered test cases, in registration order.
+    std::vector<Case>& get_cases();
+
+    /// @brief Registers a test case during static initialization, see TEST_CASE.
+    struct Registration {
+        Registration(const char* name, void (*function)());
+    };
+
+    /// @brief Records a failed check of the running test case.
+    void fail(const char* file, int line, const char* message);
+
+    /// @brief Records a failed equality check, prints both values.
+    void fail_equal(const char* file, int line, const char* expression, double actual, double expected);
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static test::Registration name##_registration(#name, name); \
+    static void name()
+
+#define CHECK(expression) \
+    do{ if(!(expression)) test::fail(__FILE__, __LINE__, #expression); }while(0)
+
+/// @brief Checks exact equality of numbers, layout math is expected to give exactly the same doubles.
+#define CHECK_EQUAL(actual, expected) \
+    do{ \
+        double check_actual = (actual); \
+        double check_expected = (expected); \
+        if(!(check_actual == check_expected)) test::fail_equal(__FILE__, __LINE__, #actual, check_actual, check_expected); \
+    }while(0)
@@ -0,0 +1,131 @@
+#include "test.h"
+#include "core/layout/unit_batch.h"
+#include "core/layout/layout_node.h"
+#include "commons/unit_conversion.h"
+#include <climits>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+/// Every kernel of UnitBatch has to give bit for bit the same results as the scalar UnitConversion into pixels.
+
+namespace {
+    const int32_t UNITS[] = {
+        LayoutNode::NOT_SET, LayoutNode::PIXEL, LayoutNode::PERCENTAGE, LayoutNode::VIEWPORT_WIDTH,
+        LayoutNode::VIEWPORT_HEIGHT, LayoutNode::FRACTION, 99, INT_MIN,
+    };
+    const double LENGTHS[] = {
+        0.0, -0.0, 1, -12.5, 0.1, 1.0 / 3, 1000.5, 1e308, -1e-300,
+        std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::infinity(),
+    };
+    const double PARENT_SIZES[] = {0.0, -0.0, 800, 333.3, 1e-5};
+
+    const double VIEWPORTS[][2] = {{1920, 1080}, {0.0, -0.0}, {333.3, 1.0 / 7}};
+
+    uint64_t get_bits(double value){
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    double scalar_to_pixels(int32_t unit, double length, double parent_size, double viewport_width, double viewport_height){
+        UnitContext context;
+        context.parent_width = parent_size;
+        context.viewport_width = viewport_width;
+        context.viewport_height = viewport_height;
+        return UnitConversion::convert_to<UnitConversion::PIXEL, UnitAxis::WIDTH>(unit, length, context);
+    }
+
+    /// @brief Fills a batch with every combination of unit, length and parent size.
+    void fill_combinations(UnitBatch& batch){
+        batch.clear();
+        for (int32_t unit : UNITS)
+        {
+            for (double length : LENGTHS)
+            {
+                for (double parent_size : PARENT_SIZES)
+                {
+                    batch.push(unit, length, parent_size);
+                }
+            }
+        }
+    }
+
+    /// @brief Converts count lengths starting at offset (unaligned and tail lengths) and compares them with the scalar conversion.
+    bool check_kernel(UnitBatch::Kernel kernel, const UnitBatch& batch, size_t offset, size_t count, double viewport_width, double viewport_height){
+        // Guards after the count catch kernels writing past the tail.
+        const double guard = -7777;
+        std::vector<double> results(count + 8, guard);
+        UnitBatch::to_pixels(kernel, batch.units.data() + offset, batch.lengths.data() + offset, batch.parent_sizes.data() + offset,
+            viewport_width, viewport_height, results.data(), count);
+
+        bool equal = true;
+        for (size_t i = 0; i < count; i++)
+        {
+            double expected = scalar_to_pixels(batch.units[offset + i], batch.lengths[offset + i], batch.parent_sizes[offset + i], viewport_width, viewport_height);
+            if(get_bits(results[i]) != get_bits(expected)){
+                std::printf("  %s: unit %d, length %.17g, parent %.17g: %.17g, expected %.17g\n", UnitBatch::get_kernel_name(kernel),
+                    batch.units[offset + i], batch.lengths[offset + i], batch.parent_sizes[offset + i], results[i], expected);
+                equal = false;
+            }
+        }
+        for (size_t i = count; i < results.size(); i++)
+        {
+            if(results[i] != guard) equal = false;
+        }
+        return equal;
+    }
+}
+
+TEST_CASE(unit_batch_kernels_match_scalar_conversion){
+    UnitBatch batch;
+    fill_combinations(batch);
+
+    int checked_kernels {0};
+    for (int kernel = UnitBatch::KERNEL_SCALAR; kernel <= UnitBatch::KERNEL_NEON; kernel++)
+    {
+        UnitBatch::Kernel batch_kernel = static_cast<UnitBatch::Kernel>(kernel);
+        if(!UnitBatch::is_kernel_supported(batch_kernel)) continue;
+        checked_kernels++;
+
+        for (const auto& viewport : VIEWPORTS)
+        {
+            CHECK(check_kernel(batch_kernel, batch, 0, batch.size(), viewport[0], viewport[1]));
+        }
+    }
+    CHECK(checked_kernels > 0);
+}
+
+TEST_CASE(unit_batch_kernels_handle_tails_and_unaligned_starts){
+    UnitBatch batch;
+    fill_combinations(batch);
+
+    for (int kernel = UnitBatch::KERNEL_SCALAR; kernel <= UnitBatch::KERNEL_NEON; kernel++)
+    {
+        UnitBatch::Kernel batch_kernel = static_cast<UnitBatch::Kernel>(kernel);
+        if(!UnitBatch::is_kernel_supported(batch_kernel)) continue;
+
+        // Counts 0 to 17 cover every remainder of 2 and 4 wide vectors, offsets make the inputs unaligned.
+        for (size_t offset = 0; offset < 3; offset++)
+        {
+            for (size_t count = 0; count <= 17; count++)
+            {
+                CHECK(check_kernel(batch_kernel, batch, offset * 13, count, 1920, 1080));
+            }
+        }
+    }
+}
+
+TEST_CASE(unit_batch_convert_uses_selected_kernel){
+    UnitBatch batch;
+    fill_combinations(batch);
+    batch.convert(1920, 1080);
+
+    CHECK(batch.results.size() == batch.size());
+    CHECK(UnitBatch::is_kernel_supported(UnitBatch::get_kernel()));
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        double expected = scalar_to_pixels(batch.units[i], batch.lengths[i], batch.parent_sizes[i], 1920, 1080);
+        CHECK(get_bits(batch.results[i]) == get_bits(expected));
+    }
+}
@@ -0,0 +1,154 @@
+#include "test.h"
+#include "core/layout/virtual_list.h"
+
+/// Offsets and visible ranges of the VirtualList.
+
+namespace {
+    struct Range {
+        size_t first;
+        size_t last;
+    };
+
+    Range get_range(VirtualList& list, double view_start, double view_size, double overscan){
+        Range range {999, 999};
+        list.get_range(view_start, view_size, overscan, range.first, range.last);
+        return range;
+    }
+}
+
+TEST_CASE(virtual_list_range_of_view){
+    VirtualList list;
+    list.resize(10, 10);
+    CHECK_EQUAL(list.get_total_size(), 100);
+
+    // Items 2 to 4 intersect [25, 45)
+    Range range = get_range(list, 25, 20, 0);
+    CHECK(range.first == 2);
+    CHECK(range.last == 5);
+
+    // A view starting and ending on item edges doesn't include the neighbours.
+    range = get_range(list, 20, 20, 0);
+    CHECK(range.first == 2);
+    CHECK(range.last == 4);
+
+    // Overscan extends both sides, clamped to the list.
+    range = get_range(list, 25, 20, 10);
+    CHECK(range.first == 1);
+    CHECK(range.last == 6);
+    range = get_range(list, 0, 20, 50);
+    CHECK(range.first == 0);
+    CHECK(range.last == 7);
+    range = get_range(list, 90, 20, 50);
+    CHECK(range.first == 4);
+    CHECK(range.last == 10);
+}
+
+TEST_CASE(virtual_list_empty_and_past_the_end){
+    VirtualList list;
+    CHECK_EQUAL(list.get_total_size(), 0);
+    Range range = get_range(list, 0, 100, 10);
+    CHECK(range.first == 0);
+    CHECK(range.last == 0);
+    range = get_range(list, -50, 100, 0);
+    CHECK(range.first == 0);
+    CHECK(range.last == 0);
+
+    list.resize(5, 10);
+    range = get_range(list, 50, 100, 0);
+    CHECK(range.first == 5);
+    CHECK(range.last == 5);
+    range = get_range(list, 150, 100, 20);
+    CHECK(range.first == 5);
+    CHECK(range.last == 5);
+    // Overscan reaches back into the list.
+    range = get_range(list, 55, 100, 10);
+    CHECK(range.first == 4);
+    CHECK(range.last == 5);
+}
+
+TEST_CASE(virtual_list_zero_size_items){
+    VirtualList list;
+    list.resize(4, 0);
+    list.set_item_size(0, 10);
+    list.set_item_size(3, 10);
+    CHECK_EQUAL(list.get_item_offset(1), 10);
+    CHECK_EQUAL(list.get_item_offset(3), 10);
+
+    // Zero size items on the edge of a view are outside of it.
+    Range range = get_range(list, 10, 5, 0);
+    CHECK(range.first == 3);
+    CHECK(range.last == 4);
+    range = get_range(list, 5, 5, 0);
+    CHECK(range.first == 0);
+    CHECK(range.last == 1);
+
+    // Only zero size items, nothing has any extent.
+    list.fill(0);
+    CHECK_EQUAL(list.get_total_size(), 0);
+    range = get_range(list, 0, 100, 0);
+    CHECK(range.first == 4);
+    CHECK(range.last == 4);
+}
+
+TEST_CASE(virtual_list_offsets_follow_item_sizes){
+    VirtualList list;
+    list.resize(5, 10);
+    CHECK_EQUAL(list.get_item_offset(2), 20);
+
+    list.set_item_size(1, 30);
+    CHECK_EQUAL(list.get_item_size(1), 30);
+    CHECK_EQUAL(list.get_item_offset(1), 10);
+    CHECK_EQUAL(list.get_item_offset(2), 40);
+    CHECK_EQUAL(list.get_total_size(), 70);
+    // The item count gives the total size, past it too.
+    CHECK_EQUAL(list.get_item_offset(5), 70);
+    CHECK_EQUAL(list.get_item_offset(50), 70);
+
+    // Several changes before a query share one rebuild from the first of them.
+    list.set_item_size(4, 5);
+    list.set_item_size(0, 0);
+    CHECK_EQUAL(list.get_item_offset(2), 30);
+    CHECK_EQUAL(list.get_total_size(), 55);
+
+    list.set_item_size(9, 100);
+    CHECK_EQUAL(list.get_item_size(9), 0);
+    CHECK_EQUAL(list.get_total_size(), 55);
+    CHECK(list.size() == 5);
+
+    Range range = get_range(list, 35, 1, 0);
+    CHECK(range.first == 2);
+    CHECK(range.last == 3);
+}
+
+TEST_CASE(virtual_list_resize_keeps_dirty_offsets){
+    VirtualList list;
+    list.resize(3, 10);
+    CHECK_EQUAL(list.get_total_size(), 30);
+
+    // Growing keeps a pending change and sizes the new items.
+    list.set_item_size(2, 20);
+    list.resize(5, 5);
+    CHECK_EQUAL(list.get_item_offset(3), 40);
+    CHECK_EQUAL(list.get_total_size(), 50);
+
+    // Growing an up to date list rebuilds only the new items.
+    list.resize(6, 1);
+    CHECK_EQUAL(list.get_item_offset(5), 50);
+    CHECK_EQUAL(list.get_total_size(), 51);
+
+    // A pending change of a removed item doesn't leave a stale total.
+    list.set_item_size(4, 100);
+    list.resize(4, 7);
+    CHECK_EQUAL(list.get_total_size(), 45);
+
+    // Shrinking below a pending change, then growing again.
+    list.set_item_size(3, 1);
+    list.resize(2, 99);
+    CHECK_EQUAL(list.get_total_size(), 20);
+    list.resize(4, 3);
+    CHECK_EQUAL(list.get_item_size(2), 3);
+    CHECK_EQUAL(list.get_total_size(), 26);
+
+    list.resize(0, 3);
+    CHECK_EQUAL(list.get_total_size(), 0);
+}